@@ -0,0 +1,152 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/AimComponent/AimComponent.h"
+
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+// Sets default values for this component's properties
+UAimComponent::UAimComponent()
+{
+	// Ticks before the owning character so the character reads a fresh ray in its own Tick
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+// Called when the game starts
+void UAimComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	AimTraceDelegate.BindUObject(this, &UAimComponent::OnAimTraceCompleted);
+
+	// Make sure the owner ticks after us so its aiming code sees this frame's state
+	if (GetOwner())
+	{
+		GetOwner()->PrimaryActorTick.AddPrerequisite(this, PrimaryComponentTick);
+	}
+}
+
+// Called every frame
+void UAimComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	GetAimState();
+	RequestAimTrace();
+}
+
+const FAimState& UAimComponent::GetAimState()
+{
+	if (AimState.FrameNumber != GFrameCounter)
+	{
+		UpdateAimRay();
+	}
+	return AimState;
+}
+
+APlayerController* UAimComponent::GetLocalPlayerController() const
+{
+	const APawn* OwningPawn = Cast<APawn>(GetOwner());
+	if (!OwningPawn) return nullptr;
+
+	APlayerController* PC = Cast<APlayerController>(OwningPawn->GetController());
+	return PC && PC->IsLocalController() ? PC : nullptr;
+}
+
+void UAimComponent::UpdateAimRay()
+{
+	AimState.FrameNumber = GFrameCounter;
+
+	const APlayerController* PC = GetLocalPlayerController();
+	const UGameViewportClient* ViewportClient = GetWorld() ? GetWorld()->GetGameViewport() : nullptr;
+
+	FVector RayOrigin;
+	FVector RayDirection;
+	bool bHasRay = false;
+	if (PC && ViewportClient)
+	{
+		FVector2D ViewportSize;
+		ViewportClient->GetViewportSize(ViewportSize);
+		const FVector2D CrosshairScreenPosition = ViewportSize * 0.5f;
+		bHasRay = PC->DeprojectScreenPositionToWorld(CrosshairScreenPosition.X, CrosshairScreenPosition.Y, RayOrigin, RayDirection);
+	}
+
+	// No viewport to deproject through yet, fall back to the view point so the aim point is never the world origin
+	if (!bHasRay)
+	{
+		const AActor* Owner = GetOwner();
+		if (!Owner) return;
+
+		FRotator ViewRotation;
+		Owner->GetActorEyesViewPoint(RayOrigin, ViewRotation);
+		RayDirection = ViewRotation.Vector();
+	}
+
+	AimState.RayOrigin = RayOrigin;
+	AimState.RayDirection = RayDirection;
+
+	// Trace results lag a frame behind, so project the last hit distance onto the current ray
+	const float AimDistance = AimState.bHasBlockingHit ? LastHitDistance : MaxAimDistance;
+	AimState.AimPoint = RayOrigin + RayDirection * AimDistance;
+}
+
+void UAimComponent::RequestAimTrace()
+{
+	UWorld* World = GetWorld();
+	if (!World || !GetLocalPlayerController()) return;
+
+	// Only one trace in flight at a time
+	if (World->IsTraceHandleValid(PendingTraceHandle, false))
+	{
+		return;
+	}
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(AimTrace), false, GetOwner());
+
+	const FVector TraceStart = AimState.RayOrigin;
+	const FVector TraceEnd = TraceStart + AimState.RayDirection * MaxAimDistance;
+
+	PendingTraceHandle = World->AsyncLineTraceByChannel(
+		EAsyncTraceType::Single,
+		TraceStart,
+		TraceEnd,
+		AimTraceChannel,
+		QueryParams,
+		FCollisionResponseParams::DefaultResponseParam,
+		&AimTraceDelegate
+	);
+}
+
+void UAimComponent::OnAimTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	if (TraceHandle != PendingTraceHandle) return;
+	PendingTraceHandle = FTraceHandle();
+
+	const FHitResult* BlockingHit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+
+	AActor* PreviousTarget = AimState.AimTarget.Get();
+	AActor* NewTarget = nullptr;
+
+	if (BlockingHit)
+	{
+		AimState.bHasBlockingHit = true;
+		LastHitDistance = BlockingHit->Distance;
+		NewTarget = BlockingHit->GetActor();
+	}
+	else
+	{
+		AimState.bHasBlockingHit = false;
+		LastHitDistance = MaxAimDistance;
+	}
+
+	AimState.AimTarget = NewTarget;
+
+	if (NewTarget != PreviousTarget)
+	{
+		OnAimTargetChanged.Broadcast(NewTarget);
+	}
+}
@@ -2,6 +2,14 @@
 
 
 #include "Components/DialogueComponent/DialogueComponent.h"
+#include "Components/AudioComponent.h"
+#include "Dialogue/Actions/DialogueActionExecutor.h"
+#include "Dialogue/Audio/DialogueVoiceStreamer.h"
+#include "Dialogue/Facts/DialogueFactSubsystem.h"
+#include "Dialogue/Graph/DialogueGraph.h"
+#include "Dialogue/Graph/DialogueGraphSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Kismet/GameplayStatics.h"
 #include "NPC/Character/NPC_BaseCharacter.h"
 #include "Player/ShowcaseProjectCharacter.h"
 #include "UserInterface/ShowcaseHUD/ShowcaseHUD.h"
@@ -15,7 +23,10 @@ UDialogueComponent::UDialogueComponent()
 	bIsInDialogue = false;
 	DialoguePartner = nullptr;
 	CurrentNodeTag = FGameplayTag::EmptyTag;
+	CurrentNodeIndex = INDEX_NONE;
 	OwnerNPC = nullptr;
+	DialogueGraph = nullptr;
+	VoiceAudioComponent = nullptr;
 }
 
 
@@ -49,6 +60,12 @@ bool UDialogueComponent::StartDialogue(AActor* Partner, FGameplayTag StartingNod
 {
 	UE_LOG(LogTemp, Log, TEXT("DialogueComponent: Starting dialogue with %s"), *GetNameSafe(Partner));
 	if (!CanStartDialogue(Partner) || !OwnerNPC) return false;
+
+	if (!ResolveDialogueGraph())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("DialogueComponent: %s has no usable dialogue table"), *GetNameSafe(OwnerNPC));
+		return false;
+	}
 		
 	DialoguePartner = Partner;
 	bIsInDialogue = true;
@@ -61,7 +78,7 @@ bool UDialogueComponent::StartDialogue(AActor* Partner, FGameplayTag StartingNod
 	UE_LOG(LogTemp, Log, TEXT("DialogueComponent: OwnerNPC %s state set to Dialogue"), *GetNameSafe(OwnerNPC));
 	
 	//Determine starting node
-	FGameplayTag NodeToStart = StartingNodeTag.IsValid() ? StartingNodeTag : OwnerNPC->NPCData.InitialDialogueNode;
+	FGameplayTag NodeToStart = StartingNodeTag.IsValid() ? StartingNodeTag : OwnerNPC->GetNPCData().InitialDialogueNode;
 
 	UE_LOG(LogTemp, Log, TEXT("DialogueComponent: Starting node tag is %s"), *NodeToStart.ToString());
 	
@@ -91,7 +108,14 @@ void UDialogueComponent::EndDialogue()
 	bIsInDialogue = false;
 	DialoguePartner = nullptr;
 	CurrentNodeTag = FGameplayTag::EmptyTag;
-	CurrentNode = FDialogueNode();
+	CurrentNodeIndex = INDEX_NONE;
+	CurrentChoiceSet.Reset();
+
+	StopVoiceClip();
+	if (UDialogueVoiceStreamer* VoiceStreamer = GetWorld() ? GetWorld()->GetSubsystem<UDialogueVoiceStreamer>() : nullptr)
+	{
+		VoiceStreamer->ReleaseAll();
+	}
 
 	//Clear any auto advance timers
 	if (GetWorld())
@@ -110,13 +134,16 @@ void UDialogueComponent::EndDialogue()
 
 void UDialogueComponent::SelectChoice(int32 ChoiceIndex)
 {
-	if (!bIsInDialogue || !CurrentNode.Choices.IsValidIndex(ChoiceIndex)) return;
+	if (!bIsInDialogue || !DialogueGraph) return;
 
-	FDialogueChoice& SelectedChoice = CurrentNode.Choices[ChoiceIndex];
+	// Only choices that passed their conditions can be taken
+	if (!CurrentChoiceSet.Contains(ChoiceIndex)) return;
+
+	const FDialogueGraphChoice& SelectedChoice = DialogueGraph->GetChoices(CurrentNodeIndex)[ChoiceIndex];
 
 	//Execute choice actions
 
-	for (const FDialogueAction& Action : SelectedChoice.Actions)
+	for (const FDialogueAction& Action : DialogueGraph->GetActions(SelectedChoice.FirstAction, SelectedChoice.NumActions))
 	{
 		ExecuteAction(Action);
 	}
@@ -128,54 +155,44 @@ void UDialogueComponent::SelectChoice(int32 ChoiceIndex)
 		return;
 	}
 
-	// Move to the next node
+	// Move to the next node, an authored target that did not resolve at compile time ends the dialogue
 	if (SelectedChoice.NextNodeTag.IsValid())
 	{
-		AdvanceToNode(SelectedChoice.NextNodeTag);
+		AdvanceToNodeIndex(SelectedChoice.NextNodeIndex);
 	}
 	
 }
 
 void UDialogueComponent::AdvanceToNode(FGameplayTag NodeTag)
 {
-	
-	if (!NodeTag.IsValid())
+	if (!NodeTag.IsValid() || !ResolveDialogueGraph())
 	{
 		EndDialogue();
 		return;
 	}
 
-	FDialogueNode* NewNode = GetDialogueNodeByTag(NodeTag);
-	if (!NewNode)
+	AdvanceToNodeIndex(DialogueGraph->FindNodeIndex(NodeTag));
+}
+
+void UDialogueComponent::AdvanceToNodeIndex(int32 NodeIndex)
+{
+	if (!EnterNode(NodeIndex))
 	{
 		EndDialogue();
 		return;
 	}
-	//Check entry conditions
-	for (const FDialogueCondition& Condition : NewNode->EntryConditions)
-	{
-		if (!EvaluateCondition(Condition))
-		{
-			EndDialogue();
-			return;
-		}
-	}
-	
-	ProcessExitActions();
-	CurrentNodeTag = NodeTag;
-	CurrentNode = *NewNode;
-	ProcessEntryActions();
 
+	PlayNodeVoiceClip(NodeIndex);
+
+	// Presentation data only, the widget reads the valid choices from GetValidChoices and the graph
+	const FDialogueNode& NodeData = DialogueGraph->GetNodeData(CurrentNodeIndex);
 	
 	// Show dialogue in UI
 	if (APlayerController* PC = GetWorld()->GetFirstPlayerController())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("DialogueComponent: Found player controller"));
-        
 		if (AShowcaseHUD* HUD = Cast<AShowcaseHUD>(PC->GetHUD()))
 		{
-			UE_LOG(LogTemp, Warning, TEXT("DialogueComponent: Found HUD, calling ShowDialogue"));
-			HUD->ShowDialogue(CurrentNode, this);
+			HUD->ShowDialogue(NodeData, this);
 		}
 		else
 		{
@@ -186,113 +203,164 @@ void UDialogueComponent::AdvanceToNode(FGameplayTag NodeTag)
 	{
 		UE_LOG(LogTemp, Error, TEXT("DialogueComponent: Could not find player controller"));
 	}
-	OnDialogueNodeChanged.Broadcast(NodeTag);
+	OnDialogueNodeChanged.Broadcast(CurrentNodeTag);
 
 	//Handle auto-advance
-	if (CurrentNode.AutoAdvanceTime > 0.0f && GetWorld())
+	if (NodeData.AutoAdvanceTime > 0.0f && GetWorld())
+	{
+		GetWorld()->GetTimerManager().SetTimer(AutoAdvanceTimer, this, &UDialogueComponent::HandleAutoAdvance, NodeData.AutoAdvanceTime, false);
+	}
+}
+
+bool UDialogueComponent::EnterNode(int32 NodeIndex)
+{
+	if (!DialogueGraph || !DialogueGraph->IsValidNodeIndex(NodeIndex))
+	{
+		return false;
+	}
+
+	// The choice that led here may have granted what the entry conditions ask for
+	ApplyStateActions();
+
+	//Check entry conditions
+	if (!FDialogueConditionOp::EvaluateAll(DialogueGraph->GetEntryConditionOps(NodeIndex), BuildConditionContext()))
 	{
-		GetWorld()->GetTimerManager().SetTimer(AutoAdvanceTimer, this, &UDialogueComponent::HandleAutoAdvance, CurrentNode.AutoAdvanceTime, false);
+		return false;
 	}
+	
+	ProcessExitActions();
+	CurrentNodeIndex = NodeIndex;
+	CurrentNodeTag = DialogueGraph->GetNode(NodeIndex).NodeTag;
+	ProcessEntryActions();
+	ApplyStateActions();
+
+	// Evaluated after entry actions so choices can depend on what the node just granted
+	CurrentChoiceSet = EvaluateChoices(NodeIndex);
+	return true;
+}
+
+void UDialogueComponent::InitializeHeadless(UDialogueGraph* InDialogueGraph)
+{
+	DialogueGraph = InDialogueGraph;
+	bIsInDialogue = DialogueGraph != nullptr;
+	CurrentNodeIndex = INDEX_NONE;
+	CurrentChoiceSet.Reset();
 }
 
 TArray<FDialogueChoice> UDialogueComponent::GetCurrentChoices()
 {
 	TArray<FDialogueChoice> ValidChoices;
+	if (!DialogueGraph) return ValidChoices;
 
-	for (const FDialogueChoice& Choice : CurrentNode.Choices)
-	{
-		bool bAllConditionsMet = true;
+	const TConstArrayView<FDialogueGraphChoice> Choices = DialogueGraph->GetChoices(CurrentNodeIndex);
+	ValidChoices.Reserve(CurrentChoiceSet.Num());
 
-		for (const FDialogueCondition& Condition : Choice.Conditions)
-		{
-			if (!EvaluateCondition(Condition))
-			{
-				bAllConditionsMet = false;
-				break;
-			}
-		}
-		if (bAllConditionsMet)
-		{
-			ValidChoices.Add(Choice);
-		}
-	}
+	CurrentChoiceSet.ForEach([this, &Choices, &ValidChoices](int32 ChoiceIndex)
+	{
+		const FDialogueGraphChoice& Choice = Choices[ChoiceIndex];
+		FDialogueChoice& ValidChoice = ValidChoices.AddDefaulted_GetRef();
+		ValidChoice.ChoiceText = Choice.ChoiceText;
+		ValidChoice.NextNodeTag = Choice.NextNodeTag;
+		ValidChoice.bEndsDialogue = Choice.bEndsDialogue;
+
+		const TConstArrayView<FDialogueCondition> Conditions = DialogueGraph->GetConditions(Choice.FirstCondition, Choice.NumConditions);
+		ValidChoice.Conditions.Append(Conditions.GetData(), Conditions.Num());
+
+		const TConstArrayView<FDialogueAction> Actions = DialogueGraph->GetActions(Choice.FirstAction, Choice.NumActions);
+		ValidChoice.Actions.Append(Actions.GetData(), Actions.Num());
+	});
 	return ValidChoices;
 }
 
 FDialogueNode UDialogueComponent::GetCurrentDialogueNode()
 {
-	return CurrentNode;
+	if (!DialogueGraph || !DialogueGraph->IsValidNodeIndex(CurrentNodeIndex))
+	{
+		return FDialogueNode();
+	}
+
+	// The compiled graph keeps choices in its own arrays, the node copy carries only the ones that passed
+	FDialogueNode Node = DialogueGraph->GetNodeData(CurrentNodeIndex);
+	Node.Choices = GetCurrentChoices();
+	return Node;
 }
 
-bool UDialogueComponent::EvaluateCondition(const FDialogueCondition& Condition)
+FDialogueChoiceSet UDialogueComponent::EvaluateChoices(int32 NodeIndex)
 {
-	// Basic condition evaluation - expand based on your needs
-	switch (Condition.ConditionType)
+	FDialogueChoiceSet ChoiceSet;
+	if (!DialogueGraph) return ChoiceSet;
+
+	const FDialogueConditionContext Context = BuildConditionContext();
+	const TConstArrayView<FDialogueGraphChoice> Choices = DialogueGraph->GetChoices(NodeIndex);
+	for (int32 ChoiceIndex = 0; ChoiceIndex < Choices.Num(); ++ChoiceIndex)
 	{
-	case EDialogueConditionType::None:
-		return true; // No condition, always true
-	case EDialogueConditionType::HasItem:
-		break;
-	case EDialogueConditionType::QuestStatus:
-		break;
-	case EDialogueConditionType::FactionRelation:
-		break;
-	case EDialogueConditionType::PlayerLevel:
-		break;
-	case EDialogueConditionType::NPCHealth:
-		if (OwnerNPC)
+		const FDialogueGraphChoice& Choice = Choices[ChoiceIndex];
+		if (FDialogueConditionOp::EvaluateAll(DialogueGraph->GetConditionOps(Choice.FirstCondition, Choice.NumConditions), Context))
 		{
-			float HealthPercentage = OwnerNPC->CurrentHealth / OwnerNPC->MaxHealth;
-			return HealthPercentage >= Condition.RequiredValue;
+			ChoiceSet.Add(ChoiceIndex);
 		}
-		break;
-	case EDialogueConditionType::TimeOfDay:
-		break;
-	case EDialogueConditionType::Custom:
-		// Implement custom condition logic
-		return true;
 	}
-	return false; // Default to false if no conditions match
+	return ChoiceSet;
+}
+
+FDialogueConditionContext UDialogueComponent::BuildConditionContext() const
+{
+	FDialogueConditionContext Context;
+	if (const UDialogueFactSubsystem* Facts = GetFactSubsystem())
+	{
+		Context.Facts = Facts->GetFactValues();
+	}
+	if (OwnerNPC && OwnerNPC->MaxHealth > 0.0f)
+	{
+		Context.NPCHealthFraction = OwnerNPC->CurrentHealth / OwnerNPC->MaxHealth;
+	}
+	return Context;
+}
+
+UDialogueFactSubsystem* UDialogueComponent::GetFactSubsystem() const
+{
+	// Headless traversal has no world, fact reads then see 0
+	const UWorld* World = GetWorld();
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UDialogueFactSubsystem>() : nullptr;
+}
+
+bool UDialogueComponent::EvaluateCondition(const FDialogueCondition& Condition)
+{
+	// Authored data goes through the compiled graph, this path is for one-off Blueprint checks
+	return FDialogueConditionOp::Compile(Condition, GetFactSubsystem()).Evaluate(BuildConditionContext());
 }
 
 void UDialogueComponent::ExecuteAction(const FDialogueAction& Action)
 {
-	// Basic action execution
-	switch (Action.ActionType)
+	// Side effects are applied by the executor in one batch at the end of the frame, the ones conditions
+	// read as soon as the next node is entered. Headless traversal has no world and skips them
+	UDialogueActionExecutor* ActionExecutor = GetWorld() ? GetWorld()->GetSubsystem<UDialogueActionExecutor>() : nullptr;
+	if (!ActionExecutor) return;
+
+	FDialogueActionContext Context;
+	Context.Speaker = OwnerNPC;
+	Context.Partner = DialoguePartner;
+	ActionExecutor->QueueAction(Action, Context);
+}
+
+void UDialogueComponent::ApplyStateActions() const
+{
+	// Conditions read facts, which the end of frame batch would only update after they were evaluated
+	if (UDialogueActionExecutor* ActionExecutor = GetWorld() ? GetWorld()->GetSubsystem<UDialogueActionExecutor>() : nullptr)
 	{
-	case EDialogueActionType::None:
-		break;
-	case EDialogueActionType::GiveItem:
-		break;
-	case EDialogueActionType::TakeItem:
-		break;
-	case EDialogueActionType::StartQuest:
-		break;
-	case EDialogueActionType::CompleteQuest:
-		break;
-	case EDialogueActionType::ChangeRelation:
-		if (OwnerNPC && Action.ActionTag.IsValid())
-		{
-			// OwnerNPC->SetFactionRelation(Action.ActionTag, Action.ActionValue);
-		}
-		break;
-	case EDialogueActionType::PlayAnimation:
-		break;
-	case EDialogueActionType::PlaySound:
-		break;
-	case EDialogueActionType::Custom:
-		break;
+		ActionExecutor->FlushStateActions();
 	}
 }
 
 void UDialogueComponent::HandleAutoAdvance()
 {
-    // Auto-advance to the first available choice or end dialogue
-	TArray<FDialogueChoice> ValidChoices = GetCurrentChoices();
+    // Auto-advance to the first available choice or end dialogue, re-evaluated since state may have changed while waiting
+	CurrentChoiceSet = EvaluateChoices(CurrentNodeIndex);
 
-	if (ValidChoices.Num() > 0)
+	if (!CurrentChoiceSet.IsEmpty())
 	{
-		SelectChoice(0);
+		SelectChoice(CurrentChoiceSet.GetFirst());
 	}
 	else
 	{
@@ -302,7 +370,9 @@ void UDialogueComponent::HandleAutoAdvance()
 
 void UDialogueComponent::ProcessEntryActions()
 {
-	for (const FDialogueAction& Action : CurrentNode.EntryActions)
+	if (!DialogueGraph) return;
+
+	for (const FDialogueAction& Action : DialogueGraph->GetEntryActions(CurrentNodeIndex))
 	{
 		ExecuteAction(Action);
 	}
@@ -310,20 +380,64 @@ void UDialogueComponent::ProcessEntryActions()
 
 void UDialogueComponent::ProcessExitActions()
 {
-	// Process exit actions of current node if any
-	// This would be implemented when you have exit actions in your dialogue nodes
+	if (!DialogueGraph) return;
+
+	for (const FDialogueAction& Action : DialogueGraph->GetExitActions(CurrentNodeIndex))
+	{
+		ExecuteAction(Action);
+	}
 }
 
-FDialogueNode* UDialogueComponent::GetDialogueNodeByTag(FGameplayTag NodeTag)
+void UDialogueComponent::PlayNodeVoiceClip(int32 NodeIndex)
 {
-	// This assumes you have a data table with dialogue nodes
-	// You'll need to set up the data table reference in the component
-	if (!OwnerNPC || !OwnerNPC->NPCData.DialogueTable)
+	StopVoiceClip();
+
+	UDialogueVoiceStreamer* VoiceStreamer = GetWorld() ? GetWorld()->GetSubsystem<UDialogueVoiceStreamer>() : nullptr;
+	if (!VoiceStreamer || !DialogueGraph) return;
+
+	// Requested before the prefetch, which then finds this clip already held instead of loading it a second time
+	const TSoftObjectPtr<USoundBase>& VoiceClip = DialogueGraph->GetNodeData(NodeIndex).VoiceClip;
+	if (!VoiceClip.IsNull())
 	{
-		return nullptr;
+		VoiceStreamer->RequestVoiceClip(VoiceClip, FOnVoiceClipReady::CreateWeakLambda(this, [this, NodeIndex](USoundBase* LoadedClip)
+		{
+			// A late load must not talk over a node the player already moved past
+			if (!LoadedClip || !bIsInDialogue || CurrentNodeIndex != NodeIndex || !OwnerNPC) return;
+
+			VoiceAudioComponent = UGameplayStatics::SpawnSoundAttached(LoadedClip, OwnerNPC->GetRootComponent());
+		}));
 	}
 
-	return OwnerNPC->NPCData.DialogueTable->FindRow<FDialogueNode>(FName(*NodeTag.ToString()), TEXT(""));
+	// Warm up the lines the next choices can lead to while this one plays
+	VoiceStreamer->PrefetchFromNode(DialogueGraph, NodeIndex, VoicePrefetchDepth);
+}
 
+void UDialogueComponent::StopVoiceClip()
+{
+	if (VoiceAudioComponent)
+	{
+		VoiceAudioComponent->Stop();
+		VoiceAudioComponent = nullptr;
+	}
 }
 
+bool UDialogueComponent::ResolveDialogueGraph()
+{
+	UDataTable* DialogueTable = OwnerNPC ? OwnerNPC->GetNPCData().DialogueTable : nullptr;
+	if (!DialogueTable)
+	{
+		DialogueGraph = nullptr;
+		return false;
+	}
+
+	// Keep the graph for the whole conversation, re-query on the next one so recompiled tables are picked up
+	if (bIsInDialogue && DialogueGraph && DialogueGraph->GetSourceTable() == DialogueTable)
+	{
+		return true;
+	}
+
+	UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(this);
+	UDialogueGraphSubsystem* GraphSubsystem = GameInstance ? GameInstance->GetSubsystem<UDialogueGraphSubsystem>() : nullptr;
+	DialogueGraph = GraphSubsystem ? GraphSubsystem->GetOrCompileGraph(DialogueTable) : nullptr;
+	return DialogueGraph != nullptr;
+}
@@ -80,7 +80,7 @@ int32 UInventoryComponent::CalculateNumberForFullStack(UItemBase* StackableItem,
 void UInventoryComponent::RemoveSingleInstanceOfItem(UItemBase* ItemToRemove)
 {
 	InventoryContents.RemoveSingle(ItemToRemove);
-	OnInventoryUpdated.Broadcast();
+	BroadcastInventoryUpdated();
 }
 
 int32 UInventoryComponent::RemoveAmountOfItem(UItemBase* ItemToRemove, int32 AmountToRemove)
@@ -88,7 +88,7 @@ int32 UInventoryComponent::RemoveAmountOfItem(UItemBase* ItemToRemove, int32 Amo
 	const int32 ActualAmountToRemove = FMath::Min(AmountToRemove, ItemToRemove->Quantity);
 	ItemToRemove->SetQuantity(ItemToRemove->Quantity - ActualAmountToRemove);
 	InventoryTotalWeight -= AmountToRemove * ItemToRemove->GetItemSingleWeight();
-	OnInventoryUpdated.Broadcast();
+	BroadcastInventoryUpdated();
 	return ActualAmountToRemove;
 }
 
@@ -155,7 +155,7 @@ int32 UInventoryComponent::HandleStackableItem(UItemBase* ItemIn, int32 Requeste
 			//if max weight capacity is reached, we should stop adding to the existing stack
 			if (InventoryTotalWeight >= InventoryWeightCapacity)
 			{
-				OnInventoryUpdated.Broadcast();
+				BroadcastInventoryUpdated();
 				return RequestedAddAmount - AmountToDistribute; // Return the amount added
 			}
 		}
@@ -164,7 +164,7 @@ int32 UInventoryComponent::HandleStackableItem(UItemBase* ItemIn, int32 Requeste
 			if (AmountToDistribute != RequestedAddAmount)
 			{
 				//This block will be reached if distrubting the item stack to existing stacks has been successful, but the weight capacity is reached
-				OnInventoryUpdated.Broadcast();
+				BroadcastInventoryUpdated();
 				return RequestedAddAmount - AmountToDistribute; // Return the amount added
 			}
 			return 0; // No valid amount to add
@@ -172,7 +172,7 @@ int32 UInventoryComponent::HandleStackableItem(UItemBase* ItemIn, int32 Requeste
 		if (AmountToDistribute <= 0)
 		{
 			// all the requested amount has been added to existing stacks
-			OnInventoryUpdated.Broadcast();
+			BroadcastInventoryUpdated();
 			return RequestedAddAmount; // All requested amount added
 		}
 		// check if there are more partial stacks of the same item
@@ -201,7 +201,7 @@ int32 UInventoryComponent::HandleStackableItem(UItemBase* ItemIn, int32 Requeste
 			return RequestedAddAmount; // All requested amount added
 		}
 	}
-	OnInventoryUpdated.Broadcast();
+	BroadcastInventoryUpdated();
 	return RequestedAddAmount - AmountToDistribute; // Return the amount added
 }
 
@@ -285,7 +285,31 @@ void UInventoryComponent::AddNewItemToInventory(UItemBase* NewItem, int32 Amount
 	{
 		UE_LOG(LogTemp, Log, TEXT("UInventoryComponent::AddNewItemToInventory: Added non-weapon item %s."), *ItemToAdd->GetName());
 	}
-	OnInventoryUpdated.Broadcast();
+	BroadcastInventoryUpdated();
 }
 
+void UInventoryComponent::BeginUpdateBatch()
+{
+	++UpdateBatchDepth;
+}
+
+void UInventoryComponent::EndUpdateBatch()
+{
+	if (!ensure(UpdateBatchDepth > 0)) return;
 
+	if (--UpdateBatchDepth == 0 && bHasPendingUpdate)
+	{
+		bHasPendingUpdate = false;
+		OnInventoryUpdated.Broadcast();
+	}
+}
+
+void UInventoryComponent::BroadcastInventoryUpdated()
+{
+	if (UpdateBatchDepth > 0)
+	{
+		bHasPendingUpdate = true;
+		return;
+	}
+	OnInventoryUpdated.Broadcast();
+}
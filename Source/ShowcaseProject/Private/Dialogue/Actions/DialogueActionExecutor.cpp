@@ -0,0 +1,388 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Dialogue/Actions/DialogueActionExecutor.h"
+
+#include "Animation/AnimMontage.h"
+#include "Components/AudioComponent.h"
+#include "Components/InventoryComponent/InventoryComponent.h"
+#include "Dialogue/Facts/DialogueFactSubsystem.h"
+#include "Engine/AssetManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/StreamableManager.h"
+#include "GameFramework/WorldSettings.h"
+#include "Items/ItemBase.h"
+#include "NPC/Character/NPC_BaseCharacter.h"
+#include "Player/ShowcaseProjectCharacter.h"
+#include "Sound/SoundBase.h"
+
+namespace
+{
+	// Quest facts hold 0 for unknown, 1 while active and 2 once completed
+	constexpr float QuestActiveValue = 1.0f;
+	constexpr float QuestCompletedValue = 2.0f;
+
+	// Actions whose result dialogue conditions can read back through facts
+	FORCEINLINE bool ChangesFacts(EDialogueActionType ActionType)
+	{
+		return ActionType == EDialogueActionType::GiveItem || ActionType == EDialogueActionType::TakeItem
+			|| ActionType == EDialogueActionType::StartQuest || ActionType == EDialogueActionType::CompleteQuest
+			|| ActionType == EDialogueActionType::ChangeRelation;
+	}
+
+	int32 GetItemQuantity(const FDialogueAction& Action)
+	{
+		const int32 Quantity = FMath::RoundToInt(Action.ActionValue);
+		if (Quantity < 1)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("DialogueActionExecutor: Item action for %s has quantity %d, using 1"), *Action.ItemRow.RowName.ToString(), Quantity);
+			return 1;
+		}
+		return Quantity;
+	}
+}
+
+void UDialogueActionExecutor::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UDialogueActionExecutor::HandlePostActorTick);
+}
+
+void UDialogueActionExecutor::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+	for (UAudioComponent* AudioComponent : AudioPool)
+	{
+		if (IsValid(AudioComponent))
+		{
+			AudioComponent->DestroyComponent();
+		}
+	}
+	AudioPool.Empty();
+	PendingActions.Empty();
+
+	Super::Deinitialize();
+}
+
+void UDialogueActionExecutor::QueueAction(const FDialogueAction& Action, const FDialogueActionContext& Context)
+{
+	if (Action.ActionType == EDialogueActionType::None && !Action.ActionTag.IsValid()) return;
+
+	FQueuedDialogueAction& QueuedAction = PendingActions.AddDefaulted_GetRef();
+	QueuedAction.Action = Action;
+	QueuedAction.Context = Context;
+}
+
+void UDialogueActionExecutor::RegisterHandler(FGameplayTag ActionTag, FDialogueActionHandler Handler)
+{
+	if (ActionTag.IsValid())
+	{
+		Handlers.Add(ActionTag, MoveTemp(Handler));
+	}
+}
+
+void UDialogueActionExecutor::UnregisterHandler(FGameplayTag ActionTag)
+{
+	Handlers.Remove(ActionTag);
+}
+
+void UDialogueActionExecutor::HandlePostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World == GetWorld() && PendingActions.Num() > 0)
+	{
+		FlushActions();
+	}
+}
+
+void UDialogueActionExecutor::FlushActions()
+{
+	Swap(PendingActions, ExecutingActions);
+
+	for (const FQueuedDialogueAction& QueuedAction : ExecutingActions)
+	{
+		ExecuteQueuedAction(QueuedAction);
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("DialogueActionExecutor: Applied %d actions"), ExecutingActions.Num());
+	ExecutingActions.Reset();
+
+	EndInventoryBatches();
+}
+
+void UDialogueActionExecutor::FlushStateActions()
+{
+	int32 NumApplied = 0;
+	for (int32 Index = 0; Index < PendingActions.Num();)
+	{
+		const FQueuedDialogueAction& Pending = PendingActions[Index];
+		if (!ChangesFacts(Pending.Action.ActionType) || FindHandler(Pending.Action.ActionTag))
+		{
+			++Index;
+			continue;
+		}
+
+		// Copied out first, fact listeners may queue more actions while this one applies
+		const FQueuedDialogueAction QueuedAction = Pending;
+		PendingActions.RemoveAt(Index);
+		ExecuteBuiltInAction(QueuedAction.Action, QueuedAction.Context);
+		++NumApplied;
+	}
+
+	if (NumApplied > 0)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("DialogueActionExecutor: Applied %d state actions ahead of the batch"), NumApplied);
+	}
+
+	// Item facts refresh on the inventory update, which the batch holds back until it closes
+	EndInventoryBatches();
+}
+
+void UDialogueActionExecutor::ExecuteQueuedAction(const FQueuedDialogueAction& QueuedAction)
+{
+	if (const FDialogueActionHandler* Handler = FindHandler(QueuedAction.Action.ActionTag))
+	{
+		Handler->ExecuteIfBound(QueuedAction.Action, QueuedAction.Context);
+	}
+	else
+	{
+		ExecuteBuiltInAction(QueuedAction.Action, QueuedAction.Context);
+	}
+}
+
+void UDialogueActionExecutor::EndInventoryBatches()
+{
+	// Close the inventory transactions opened during the batch, one update broadcast each
+	for (const TWeakObjectPtr<UInventoryComponent>& Inventory : BatchedInventories)
+	{
+		if (UInventoryComponent* BatchedInventory = Inventory.Get())
+		{
+			BatchedInventory->EndUpdateBatch();
+		}
+	}
+	BatchedInventories.Reset();
+}
+
+const FDialogueActionHandler* UDialogueActionExecutor::FindHandler(FGameplayTag ActionTag) const
+{
+	if (Handlers.IsEmpty()) return nullptr;
+
+	// Most specific registration wins, then walk up the tag hierarchy
+	for (FGameplayTag Tag = ActionTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+	{
+		if (const FDialogueActionHandler* Handler = Handlers.Find(Tag))
+		{
+			return Handler;
+		}
+	}
+	return nullptr;
+}
+
+void UDialogueActionExecutor::ExecuteBuiltInAction(const FDialogueAction& Action, const FDialogueActionContext& Context)
+{
+	switch (Action.ActionType)
+	{
+	case EDialogueActionType::None:
+		break;
+	case EDialogueActionType::GiveItem:
+		GiveItem(Action, Context);
+		break;
+	case EDialogueActionType::TakeItem:
+		TakeItem(Action, Context);
+		break;
+	case EDialogueActionType::StartQuest:
+		SetFact(Action.ActionTag, QuestActiveValue, false);
+		break;
+	case EDialogueActionType::CompleteQuest:
+		SetFact(Action.ActionTag, QuestCompletedValue, false);
+		break;
+	case EDialogueActionType::ChangeRelation:
+		SetFact(Action.ActionTag, Action.ActionValue, true);
+		break;
+	case EDialogueActionType::PlayAnimation:
+	case EDialogueActionType::PlaySound:
+		{
+			if (Action.ActionAsset.IsNull()) break;
+
+			const bool bIsSound = Action.ActionType == EDialogueActionType::PlaySound;
+			if (UObject* LoadedAsset = Action.ActionAsset.Get())
+			{
+				PlayActionAsset(LoadedAsset, bIsSound, Context);
+				break;
+			}
+
+			// Not resident yet, play once streamed in
+			const TSoftObjectPtr<UObject> Asset = Action.ActionAsset;
+			UAssetManager::GetStreamableManager().RequestAsyncLoad(Asset.ToSoftObjectPath(),
+				FStreamableDelegate::CreateWeakLambda(this, [this, Asset, Context, bIsSound]()
+				{
+					PlayActionAsset(Asset.Get(), bIsSound, Context);
+				}));
+		}
+		break;
+	case EDialogueActionType::Custom:
+		UE_LOG(LogTemp, Warning, TEXT("DialogueActionExecutor: No handler registered for custom action %s"), *Action.ActionTag.ToString());
+		break;
+	}
+}
+
+UInventoryComponent* UDialogueActionExecutor::GetBatchedInventory(const FDialogueActionContext& Context)
+{
+	const AShowcaseProjectCharacter* Player = Cast<AShowcaseProjectCharacter>(Context.Partner.Get());
+	UInventoryComponent* Inventory = Player ? Player->GetInventory() : nullptr;
+	if (!Inventory) return nullptr;
+
+	// First item action on this inventory in the batch opens its transaction
+	if (!BatchedInventories.Contains(Inventory))
+	{
+		Inventory->BeginUpdateBatch();
+		BatchedInventories.Add(Inventory);
+	}
+	return Inventory;
+}
+
+void UDialogueActionExecutor::GiveItem(const FDialogueAction& Action, const FDialogueActionContext& Context)
+{
+	const FItemData* ItemData = Action.ItemRow.GetRow<FItemData>(TEXT("DialogueActionExecutor"));
+	UInventoryComponent* Inventory = ItemData ? GetBatchedInventory(Context) : nullptr;
+	if (!Inventory) return;
+
+	// An item holds at most one stack, larger amounts go in one stack at a time through the inventory's add path
+	const int32 StackSize = ItemData->ItemNumericData.bIsStackable ? FMath::Max(ItemData->ItemNumericData.MaxStackSize, 1) : 1;
+	const int32 Quantity = GetItemQuantity(Action);
+
+	int32 NumAdded = 0;
+	while (NumAdded < Quantity)
+	{
+		const int32 StackQuantity = FMath::Min(Quantity - NumAdded, StackSize);
+		UItemBase* Item = UItemBase::CreateFromItemData(Inventory, UItemBase::StaticClass(), *ItemData);
+		Item->SetQuantity(StackQuantity);
+
+		// Nothing else references the new item, the inventory can take it as is instead of copying it again
+		Item->bIsCopy = true;
+		const FItemAddResult AddResult = Inventory->HandleAddItem(Item);
+		NumAdded += AddResult.ActualAmountAdded;
+
+		if (AddResult.ActualAmountAdded < StackQuantity) break;
+	}
+
+	if (NumAdded < Quantity)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("DialogueActionExecutor: Inventory of %s only took %d of %d %s"),
+			*GetNameSafe(Context.Partner.Get()), NumAdded, Quantity, *Action.ItemRow.RowName.ToString());
+	}
+}
+
+void UDialogueActionExecutor::TakeItem(const FDialogueAction& Action, const FDialogueActionContext& Context)
+{
+	UInventoryComponent* Inventory = Action.ItemRow.RowName.IsNone() ? nullptr : GetBatchedInventory(Context);
+	if (!Inventory) return;
+
+	int32 RemainingToTake = GetItemQuantity(Action);
+	for (UItemBase* Item : Inventory->GetInventoryContents())
+	{
+		if (!Item || Item->ItemID != Action.ItemRow.RowName) continue;
+
+		RemainingToTake -= Inventory->RemoveAmountOfItem(Item, RemainingToTake);
+		if (Item->Quantity <= 0)
+		{
+			Inventory->RemoveSingleInstanceOfItem(Item);
+		}
+		if (RemainingToTake <= 0) break;
+	}
+}
+
+void UDialogueActionExecutor::SetFact(FGameplayTag FactTag, float Value, bool bAdditive) const
+{
+	const UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+	UDialogueFactSubsystem* Facts = GameInstance ? GameInstance->GetSubsystem<UDialogueFactSubsystem>() : nullptr;
+	if (!Facts || !FactTag.IsValid()) return;
+
+	if (bAdditive)
+	{
+		Facts->AddToFact(FactTag, Value);
+	}
+	else
+	{
+		Facts->SetFact(FactTag, Value);
+	}
+}
+
+void UDialogueActionExecutor::PlayActionAsset(UObject* Asset, bool bIsSound, const FDialogueActionContext& Context)
+{
+	if (bIsSound)
+	{
+		PlaySound(Cast<USoundBase>(Asset), Context);
+	}
+	else
+	{
+		PlayMontage(Cast<UAnimMontage>(Asset), Context);
+	}
+}
+
+void UDialogueActionExecutor::PlaySound(USoundBase* Sound, const FDialogueActionContext& Context)
+{
+	UAudioComponent* AudioComponent = Sound ? AcquireAudioComponent() : nullptr;
+	if (!AudioComponent) return;
+
+	if (const ANPC_BaseCharacter* Speaker = Context.Speaker.Get())
+	{
+		AudioComponent->AttachToComponent(Speaker->GetRootComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	}
+	AudioComponent->SetSound(Sound);
+	AudioComponent->Play();
+}
+
+void UDialogueActionExecutor::PlayMontage(UAnimMontage* Montage, const FDialogueActionContext& Context) const
+{
+	if (ANPC_BaseCharacter* Speaker = Context.Speaker.Get())
+	{
+		if (Montage)
+		{
+			Speaker->PlayAnimMontage(Montage);
+		}
+	}
+}
+
+UAudioComponent* UDialogueActionExecutor::AcquireAudioComponent()
+{
+	AudioPool.RemoveAll([](const UAudioComponent* AudioComponent) { return !IsValid(AudioComponent); });
+
+	for (UAudioComponent* AudioComponent : AudioPool)
+	{
+		if (!AudioComponent->IsPlaying())
+		{
+			return AudioComponent;
+		}
+	}
+
+	if (AudioPool.Num() >= MaxPooledAudioComponents)
+	{
+		UAudioComponent* Stolen = AudioPool[NextAudioSteal++ % AudioPool.Num()];
+		Stolen->Stop();
+		Stolen->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+		return Stolen;
+	}
+
+	// Pooled components live on the world settings actor so they outlive the NPCs they get attached to
+	AWorldSettings* WorldSettings = GetWorld() ? GetWorld()->GetWorldSettings() : nullptr;
+	if (!WorldSettings) return nullptr;
+
+	UAudioComponent* AudioComponent = NewObject<UAudioComponent>(WorldSettings);
+	AudioComponent->bAutoActivate = false;
+	AudioComponent->bAutoDestroy = false;
+	AudioComponent->OnAudioFinishedNative.AddUObject(this, &UDialogueActionExecutor::HandleAudioFinished);
+	AudioComponent->RegisterComponent();
+	AudioPool.Add(AudioComponent);
+	return AudioComponent;
+}
+
+void UDialogueActionExecutor::HandleAudioFinished(UAudioComponent* AudioComponent)
+{
+	// Back to the pool unattached, so it neither follows nor goes down with the last speaker
+	if (IsValid(AudioComponent))
+	{
+		AudioComponent->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+	}
+}
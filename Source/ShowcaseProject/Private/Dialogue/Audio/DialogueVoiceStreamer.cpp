@@ -0,0 +1,143 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Dialogue/Audio/DialogueVoiceStreamer.h"
+
+#include "Dialogue/Graph/DialogueGraph.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Sound/SoundBase.h"
+
+void UDialogueVoiceStreamer::Deinitialize()
+{
+	ReleaseAll();
+	Super::Deinitialize();
+}
+
+void UDialogueVoiceStreamer::PrefetchFromNode(const UDialogueGraph* Graph, int32 NodeIndex, int32 PrefetchDepth)
+{
+	if (!Graph || !Graph->IsValidNodeIndex(NodeIndex)) return;
+
+	bHasPrefetched = true;
+	WantedClips.Reset();
+	Frontier.Reset();
+	VisitedNodes.Init(false, Graph->NumNodes());
+
+	Frontier.Add(NodeIndex);
+	VisitedNodes[NodeIndex] = true;
+
+	// Breadth-first over choice edges, depth 0 is the current node
+	for (int32 Depth = 0; Depth <= PrefetchDepth && Frontier.Num() > 0; ++Depth)
+	{
+		NextFrontier.Reset();
+		for (const int32 FrontierNode : Frontier)
+		{
+			const FSoftObjectPath& ClipPath = Graph->GetNodeData(FrontierNode).VoiceClip.ToSoftObjectPath();
+			if (ClipPath.IsValid())
+			{
+				WantedClips.Add(ClipPath);
+			}
+
+			for (const FDialogueGraphChoice& Choice : Graph->GetChoices(FrontierNode))
+			{
+				if (Choice.NextNodeIndex != INDEX_NONE && !VisitedNodes[Choice.NextNodeIndex])
+				{
+					VisitedNodes[Choice.NextNodeIndex] = true;
+					NextFrontier.Add(Choice.NextNodeIndex);
+				}
+			}
+		}
+		Swap(Frontier, NextFrontier);
+	}
+
+	// Release what the conversation can no longer reach
+	for (auto It = HeldClips.CreateIterator(); It; ++It)
+	{
+		if (!WantedClips.Contains(It.Key()))
+		{
+			if (It.Value().IsValid())
+			{
+				It.Value()->ReleaseHandle();
+			}
+			It.RemoveCurrent();
+		}
+	}
+
+	for (const FSoftObjectPath& ClipPath : WantedClips)
+	{
+		HoldClip(ClipPath);
+	}
+}
+
+void UDialogueVoiceStreamer::RequestVoiceClip(const TSoftObjectPtr<USoundBase>& VoiceClip, FOnVoiceClipReady OnReady)
+{
+	if (VoiceClip.IsNull()) return;
+
+	if (USoundBase* LoadedClip = VoiceClip.Get())
+	{
+		++CacheHits;
+		OnReady.ExecuteIfBound(LoadedClip);
+		return;
+	}
+
+	// A clip the prefetch already has in flight counts as a hit, it started loading ahead of use.
+	// Before the first prefetch of a conversation nothing could have been ahead, so that line is not counted
+	const FSoftObjectPath ClipPath = VoiceClip.ToSoftObjectPath();
+	if (HeldClips.Contains(ClipPath))
+	{
+		++CacheHits;
+	}
+	else if (bHasPrefetched)
+	{
+		++CacheMisses;
+		UE_LOG(LogTemp, Verbose, TEXT("DialogueVoiceStreamer: Cache miss for %s"), *VoiceClip.ToString());
+	}
+
+	// Also raises the priority of a prefetch still in flight
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(ClipPath,
+		FStreamableDelegate::CreateWeakLambda(this, [VoiceClip, OnReady]()
+		{
+			OnReady.ExecuteIfBound(VoiceClip.Get());
+		}), FStreamableManager::AsyncLoadHighPriority);
+
+	if (Handle.IsValid() && !HeldClips.Contains(ClipPath))
+	{
+		HeldClips.Add(ClipPath, Handle);
+	}
+}
+
+void UDialogueVoiceStreamer::ReleaseAll()
+{
+	for (TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& HeldClip : HeldClips)
+	{
+		if (HeldClip.Value.IsValid())
+		{
+			HeldClip.Value->ReleaseHandle();
+		}
+	}
+	HeldClips.Empty();
+	bHasPrefetched = false;
+
+	if (CacheHits + CacheMisses > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("DialogueVoiceStreamer: Voice cache hit rate %.1f%% (%d hits, %d misses)"),
+			GetCacheHitRate() * 100.0f, CacheHits, CacheMisses);
+	}
+}
+
+float UDialogueVoiceStreamer::GetCacheHitRate() const
+{
+	const int32 Requests = CacheHits + CacheMisses;
+	return Requests > 0 ? static_cast<float>(CacheHits) / Requests : 0.0f;
+}
+
+void UDialogueVoiceStreamer::HoldClip(const FSoftObjectPath& ClipPath)
+{
+	if (HeldClips.Contains(ClipPath)) return;
+
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(ClipPath, FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority);
+	if (Handle.IsValid())
+	{
+		HeldClips.Add(ClipPath, Handle);
+	}
+}
@@ -0,0 +1,353 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Dialogue/Barks/DialogueBarkSubsystem.h"
+
+#include "Components/AudioComponent.h"
+#include "Dialogue/Facts/DialogueFactSubsystem.h"
+#include "Dialogue/Graph/DialogueGraph.h"
+#include "Dialogue/Graph/DialogueGraphSubsystem.h"
+#include "Engine/AssetManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/StreamableManager.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "NPC/Character/NPC_BaseCharacter.h"
+#include "Sound/SoundBase.h"
+
+void UDialogueBarkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	ActiveBarks.SetNum(MaxConcurrentBarks);
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UDialogueBarkSubsystem::HandlePostActorTick);
+}
+
+void UDialogueBarkSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+	for (UAudioComponent* AudioComponent : AudioPool)
+	{
+		if (IsValid(AudioComponent))
+		{
+			AudioComponent->DestroyComponent();
+		}
+	}
+	AudioPool.Empty();
+	ActiveBarks.Empty();
+	PendingBarks.Empty();
+	NextBarkTimes.Empty();
+	BarkNodeCache.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UDialogueBarkSubsystem::RequestBark(ANPC_BaseCharacter* Speaker, FGameplayTag BarkTag, EBarkPriority Priority)
+{
+	if (!Speaker || !BarkTag.IsValid() || !Speaker->IsAlive() || Speaker->bIsInDialogue) return false;
+
+	// Distance first, everything after this point costs something
+	FVector ListenerLocation;
+	if (!GetListenerLocation(ListenerLocation)) return false;
+
+	const float DistanceSquared = FVector::DistSquared(ListenerLocation, Speaker->GetActorLocation());
+	if (DistanceSquared > FMath::Square(MaxBarkDistance)) return false;
+
+	if (const double* NextBarkTime = NextBarkTimes.Find(Speaker))
+	{
+		if (*NextBarkTime > GetWorld()->GetTimeSeconds()) return false;
+	}
+
+	// One request per NPC and frame, the most important one wins
+	for (FPendingBark& Pending : PendingBarks)
+	{
+		if (Pending.Speaker == Speaker)
+		{
+			if (Priority > Pending.Priority)
+			{
+				Pending.BarkTag = BarkTag;
+				Pending.Priority = Priority;
+			}
+
+			// Resolution ranks on distance, keep it as of the latest request
+			Pending.DistanceSquared = DistanceSquared;
+			return true;
+		}
+	}
+
+	FPendingBark& Pending = PendingBarks.AddDefaulted_GetRef();
+	Pending.Speaker = Speaker;
+	Pending.BarkTag = BarkTag;
+	Pending.Priority = Priority;
+	Pending.DistanceSquared = DistanceSquared;
+	return true;
+}
+
+bool UDialogueBarkSubsystem::IsBarking(const ANPC_BaseCharacter* Speaker) const
+{
+	for (const FActiveBark& ActiveBark : ActiveBarks)
+	{
+		if (ActiveBark.IsActive() && ActiveBark.Speaker == Speaker)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void UDialogueBarkSubsystem::HandlePostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld()) return;
+
+	const double Now = World->GetTimeSeconds();
+	ExpireBarks(Now);
+
+	if (PendingBarks.Num() == 0) return;
+
+	PendingBarks.Sort([](const FPendingBark& A, const FPendingBark& B)
+	{
+		return A.Priority != B.Priority ? A.Priority > B.Priority : A.DistanceSquared < B.DistanceSquared;
+	});
+
+	int32 NumStarted = 0;
+	for (const FPendingBark& Request : PendingBarks)
+	{
+		const int32 Slot = FindBarkSlot(Request.Priority);
+
+		// Sorted by priority, nothing after this one can get a slot either
+		if (Slot == INDEX_NONE) break;
+
+		if (StartBark(Slot, Request, Now))
+		{
+			++NumStarted;
+		}
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("DialogueBarkSubsystem: Started %d of %d bark requests"), NumStarted, PendingBarks.Num());
+	PendingBarks.Reset();
+
+	// Cooldowns that ran out are no longer worth keeping
+	for (auto It = NextBarkTimes.CreateIterator(); It; ++It)
+	{
+		if (It.Value() <= Now)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool UDialogueBarkSubsystem::GetListenerLocation(FVector& OutLocation) const
+{
+	const APlayerController* PC = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+	if (!PC) return false;
+
+	FRotator ViewRotation;
+	PC->GetPlayerViewPoint(OutLocation, ViewRotation);
+	return true;
+}
+
+void UDialogueBarkSubsystem::ExpireBarks(double Now)
+{
+	for (int32 Slot = 0; Slot < ActiveBarks.Num(); ++Slot)
+	{
+		const FActiveBark& ActiveBark = ActiveBarks[Slot];
+		if (ActiveBark.IsActive() && (ActiveBark.EndTime <= Now || !ActiveBark.Speaker.IsValid() || !ActiveBark.Speaker->IsAlive()))
+		{
+			StopBark(Slot);
+		}
+	}
+}
+
+void UDialogueBarkSubsystem::StopBark(int32 Slot)
+{
+	FActiveBark& ActiveBark = ActiveBarks[Slot];
+	if (!ActiveBark.IsActive()) return;
+
+	if (AudioPool.IsValidIndex(Slot) && IsValid(AudioPool[Slot]))
+	{
+		AudioPool[Slot]->Stop();
+	}
+
+	if (ActiveBark.bHasSubtitle)
+	{
+		--NumActiveSubtitles;
+	}
+
+	ANPC_BaseCharacter* Speaker = ActiveBark.Speaker.Get();
+	ActiveBark = FActiveBark();
+	OnBarkEnded.Broadcast(Speaker);
+}
+
+int32 UDialogueBarkSubsystem::FindBarkSlot(EBarkPriority Priority) const
+{
+	int32 PreemptSlot = INDEX_NONE;
+	for (int32 Slot = 0; Slot < ActiveBarks.Num(); ++Slot)
+	{
+		const FActiveBark& ActiveBark = ActiveBarks[Slot];
+		if (!ActiveBark.IsActive())
+		{
+			return Slot;
+		}
+
+		// Lowest priority first, the one closest to finishing among equals
+		if (ActiveBark.Priority < Priority && (PreemptSlot == INDEX_NONE
+			|| ActiveBark.Priority < ActiveBarks[PreemptSlot].Priority
+			|| (ActiveBark.Priority == ActiveBarks[PreemptSlot].Priority && ActiveBark.EndTime < ActiveBarks[PreemptSlot].EndTime)))
+		{
+			PreemptSlot = Slot;
+		}
+	}
+	return PreemptSlot;
+}
+
+int32 UDialogueBarkSubsystem::SelectBarkNode(const ANPC_BaseCharacter& Speaker, const UDialogueGraph& Graph, FGameplayTag BarkTag)
+{
+	const TArray<int32>& BarkNodes = GetBarkNodes(Graph, BarkTag);
+	if (BarkNodes.Num() == 0) return INDEX_NONE;
+
+	FDialogueConditionContext Context;
+	const UGameInstance* GameInstance = GetWorld()->GetGameInstance();
+	if (const UDialogueFactSubsystem* Facts = GameInstance ? GameInstance->GetSubsystem<UDialogueFactSubsystem>() : nullptr)
+	{
+		Context.Facts = Facts->GetFactValues();
+	}
+	if (Speaker.MaxHealth > 0.0f)
+	{
+		Context.NPCHealthFraction = Speaker.CurrentHealth / Speaker.MaxHealth;
+	}
+
+	TArray<int32, TInlineAllocator<8>> Candidates;
+	for (const int32 NodeIndex : BarkNodes)
+	{
+		if (FDialogueConditionOp::EvaluateAll(Graph.GetEntryConditionOps(NodeIndex), Context))
+		{
+			Candidates.Add(NodeIndex);
+		}
+	}
+	return Candidates.Num() > 0 ? Candidates[FMath::RandHelper(Candidates.Num())] : INDEX_NONE;
+}
+
+const TArray<int32>& UDialogueBarkSubsystem::GetBarkNodes(const UDialogueGraph& Graph, FGameplayTag BarkTag)
+{
+	const TPair<TObjectKey<UDialogueGraph>, FGameplayTag> CacheKey(&Graph, BarkTag);
+	if (const TArray<int32>* Cached = BarkNodeCache.Find(CacheKey))
+	{
+		return *Cached;
+	}
+
+	TArray<int32>& BarkNodes = BarkNodeCache.Add(CacheKey);
+	for (int32 NodeIndex = 0; NodeIndex < Graph.NumNodes(); ++NodeIndex)
+	{
+		if (Graph.GetNode(NodeIndex).NodeTag.MatchesTag(BarkTag))
+		{
+			BarkNodes.Add(NodeIndex);
+		}
+	}
+	return BarkNodes;
+}
+
+bool UDialogueBarkSubsystem::StartBark(int32 Slot, const FPendingBark& Request, double Now)
+{
+	ANPC_BaseCharacter* Speaker = Request.Speaker.Get();
+	if (!Speaker || !Speaker->IsAlive() || Speaker->bIsInDialogue || IsBarking(Speaker)) return false;
+
+	const UGameInstance* GameInstance = GetWorld()->GetGameInstance();
+	UDialogueGraphSubsystem* GraphSubsystem = GameInstance ? GameInstance->GetSubsystem<UDialogueGraphSubsystem>() : nullptr;
+	const UDialogueGraph* Graph = GraphSubsystem ? GraphSubsystem->GetOrCompileGraph(Speaker->GetNPCData().DialogueTable) : nullptr;
+
+	const int32 NodeIndex = Graph ? SelectBarkNode(*Speaker, *Graph, Request.BarkTag) : INDEX_NONE;
+
+	TSoftObjectPtr<USoundBase> Clip;
+	FText SubtitleText;
+	if (NodeIndex != INDEX_NONE)
+	{
+		const FDialogueNode& NodeData = Graph->GetNodeData(NodeIndex);
+		Clip = NodeData.VoiceClip;
+		SubtitleText = NodeData.DialogueText;
+	}
+	else if (const TArray<USoundBase*>& VoiceLines = Speaker->GetNPCData().VoiceLines; VoiceLines.Num() > 0)
+	{
+		// No authored bark line, fall back to the NPC's generic voice lines without a subtitle
+		Clip = VoiceLines[FMath::RandHelper(VoiceLines.Num())];
+	}
+
+	if (Clip.IsNull() && SubtitleText.IsEmpty()) return false;
+
+	StopBark(Slot);
+
+	FActiveBark& ActiveBark = ActiveBarks[Slot];
+	ActiveBark.Speaker = Speaker;
+	ActiveBark.Priority = Request.Priority;
+	ActiveBark.Serial = ++NextBarkSerial;
+
+	// Real length is known once the clip is playing, until then go by the subtitle
+	float Duration = FMath::Max(MinBarkDuration, SubtitleText.ToString().Len() * SecondsPerSubtitleCharacter);
+	if (const USoundBase* LoadedClip = Clip.Get())
+	{
+		Duration = FMath::Max(Duration, LoadedClip->GetDuration());
+	}
+	ActiveBark.EndTime = Now + Duration;
+
+	NextBarkTimes.Add(Speaker, Now + BarkCooldown);
+
+	if (!SubtitleText.IsEmpty() && NumActiveSubtitles < MaxBarkSubtitles)
+	{
+		ActiveBark.bHasSubtitle = true;
+		++NumActiveSubtitles;
+		OnBarkSubtitle.Broadcast(Speaker, SubtitleText, Duration);
+	}
+
+	if (USoundBase* LoadedClip = Clip.Get())
+	{
+		PlayBarkClip(Slot, ActiveBark.Serial, LoadedClip);
+	}
+	else if (!Clip.IsNull())
+	{
+		const uint32 Serial = ActiveBark.Serial;
+		UAssetManager::GetStreamableManager().RequestAsyncLoad(Clip.ToSoftObjectPath(),
+			FStreamableDelegate::CreateWeakLambda(this, [this, Slot, Serial, Clip]()
+			{
+				PlayBarkClip(Slot, Serial, Clip.Get());
+			}), FStreamableManager::AsyncLoadHighPriority);
+	}
+	return true;
+}
+
+void UDialogueBarkSubsystem::PlayBarkClip(int32 Slot, uint32 Serial, USoundBase* Clip)
+{
+	// The slot may have been preempted or expired while the clip was loading
+	if (!Clip || !ActiveBarks.IsValidIndex(Slot) || ActiveBarks[Slot].Serial != Serial || !ActiveBarks[Slot].IsActive()) return;
+
+	ANPC_BaseCharacter* Speaker = ActiveBarks[Slot].Speaker.Get();
+	UAudioComponent* AudioComponent = Speaker ? GetSlotAudioComponent(Slot) : nullptr;
+	if (!AudioComponent) return;
+
+	AudioComponent->AttachToComponent(Speaker->GetRootComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	AudioComponent->SetSound(Clip);
+	AudioComponent->Play();
+
+	const double ClipEndTime = GetWorld()->GetTimeSeconds() + Clip->GetDuration();
+	ActiveBarks[Slot].EndTime = FMath::Max(ActiveBarks[Slot].EndTime, ClipEndTime);
+}
+
+UAudioComponent* UDialogueBarkSubsystem::GetSlotAudioComponent(int32 Slot)
+{
+	if (AudioPool.IsValidIndex(Slot) && IsValid(AudioPool[Slot]))
+	{
+		return AudioPool[Slot];
+	}
+
+	// Same ownership as the action executor's pool, the components outlive the NPCs they get attached to
+	AWorldSettings* WorldSettings = GetWorld() ? GetWorld()->GetWorldSettings() : nullptr;
+	if (!WorldSettings) return nullptr;
+
+	AudioPool.SetNum(MaxConcurrentBarks);
+
+	UAudioComponent* AudioComponent = NewObject<UAudioComponent>(WorldSettings);
+	AudioComponent->bAutoActivate = false;
+	AudioComponent->bAutoDestroy = false;
+	AudioComponent->RegisterComponent();
+	AudioPool[Slot] = AudioComponent;
+	return AudioComponent;
+}
@@ -0,0 +1,272 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Dialogue/Commandlets/DialogueGraphCommandlet.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Components/DialogueComponent/DialogueComponent.h"
+#include "Data/FST_NPCDataStruct.h"
+#include "Dialogue/Graph/DialogueGraph.h"
+#include "Engine/DataTable.h"
+#include "Math/RandomStream.h"
+
+UDialogueGraphCommandlet::UDialogueGraphCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UDialogueGraphCommandlet::Main(const FString& Params)
+{
+	int32 Iterations = 1000;
+	int32 MaxSteps = 256;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	FParse::Value(*Params, TEXT("MaxSteps="), MaxSteps);
+	const bool bRunBenchmark = !FParse::Param(*Params, TEXT("NoBenchmark"));
+
+	TMap<UDataTable*, TArray<FGameplayTag>> EntryTagsByTable;
+	GatherDialogueTables(EntryTagsByTable);
+
+	UE_LOG(LogTemp, Display, TEXT("DialogueGraphCommandlet: Checking %d dialogue tables"), EntryTagsByTable.Num());
+
+	int32 TotalErrors = 0;
+	for (const TPair<UDataTable*, TArray<FGameplayTag>>& TableEntry : EntryTagsByTable)
+	{
+		// Compiled without a fact store, fact conditions read 0 during the benchmark
+		UDialogueGraph* Graph = UDialogueGraph::Compile(TableEntry.Key, GetTransientPackage(), nullptr);
+		if (!Graph)
+		{
+			UE_LOG(LogTemp, Error, TEXT("DialogueGraphCommandlet: %s could not be compiled"), *TableEntry.Key->GetPathName());
+			++TotalErrors;
+			continue;
+		}
+
+		TArray<int32> EntryNodes;
+		for (const FGameplayTag& EntryTag : TableEntry.Value)
+		{
+			const int32 EntryNode = Graph->FindNodeIndex(EntryTag);
+			if (EntryNode == INDEX_NONE)
+			{
+				UE_LOG(LogTemp, Error, TEXT("DialogueGraphCommandlet: %s: NPC initial node %s does not exist"), *TableEntry.Key->GetName(), *EntryTag.ToString());
+				++TotalErrors;
+				continue;
+			}
+			EntryNodes.AddUnique(EntryNode);
+		}
+
+		// Bark lines are entered directly by the bark scheduler
+		static const FGameplayTag BarkRoot = FGameplayTag::RequestGameplayTag(TEXT("Bark"), false);
+		for (int32 NodeIndex = 0; BarkRoot.IsValid() && NodeIndex < Graph->NumNodes(); ++NodeIndex)
+		{
+			if (Graph->GetNode(NodeIndex).NodeTag.MatchesTag(BarkRoot))
+			{
+				EntryNodes.AddUnique(NodeIndex);
+			}
+		}
+
+		TotalErrors += ValidateGraph(*Graph, EntryNodes);
+
+		if (bRunBenchmark && EntryNodes.Num() > 0)
+		{
+			BenchmarkGraph(*Graph, EntryNodes, Iterations, MaxSteps);
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("DialogueGraphCommandlet: Finished with %d error(s)"), TotalErrors);
+	return TotalErrors > 0 ? 1 : 0;
+}
+
+void UDialogueGraphCommandlet::GatherDialogueTables(TMap<UDataTable*, TArray<FGameplayTag>>& OutEntryTags) const
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> TableAssets;
+	AssetRegistry.GetAssetsByClass(UDataTable::StaticClass()->GetClassPathName(), TableAssets);
+
+	for (const FAssetData& TableAsset : TableAssets)
+	{
+		// Filter on the row struct tag first so unrelated tables are never loaded
+		FString RowStructPath;
+		if (!TableAsset.GetTagValue(TEXT("RowStructure"), RowStructPath)) continue;
+
+		const UScriptStruct* RowStruct = FindObject<UScriptStruct>(nullptr, *RowStructPath);
+		if (!RowStruct || !RowStruct->IsChildOf(FST_NPCDataStruct::StaticStruct())) continue;
+
+		const UDataTable* NPCTable = Cast<UDataTable>(TableAsset.GetAsset());
+		if (!NPCTable || !NPCTable->GetRowStruct() || !NPCTable->GetRowStruct()->IsChildOf(FST_NPCDataStruct::StaticStruct()))
+		{
+			continue;
+		}
+
+		for (const TPair<FName, uint8*>& Row : NPCTable->GetRowMap())
+		{
+			const FST_NPCDataStruct* NPCData = reinterpret_cast<const FST_NPCDataStruct*>(Row.Value);
+			if (!NPCData->DialogueTable) continue;
+
+			TArray<FGameplayTag>& EntryTags = OutEntryTags.FindOrAdd(NPCData->DialogueTable);
+			if (NPCData->InitialDialogueNode.IsValid())
+			{
+				EntryTags.AddUnique(NPCData->InitialDialogueNode);
+			}
+		}
+	}
+}
+
+int32 UDialogueGraphCommandlet::ValidateGraph(const UDialogueGraph& Graph, const TArray<int32>& EntryNodes) const
+{
+	const FString TableName = GetNameSafe(Graph.GetSourceTable());
+	const int32 NumNodes = Graph.NumNodes();
+	int32 Errors = 0;
+
+	TArray<TArray<int32>> IncomingEdges;
+	IncomingEdges.SetNum(NumNodes);
+	TBitArray<> CanExit(false, NumNodes);
+	TArray<int32> Pending;
+
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+	{
+		const FDialogueGraphNode& Node = Graph.GetNode(NodeIndex);
+		const TConstArrayView<FDialogueGraphChoice> Choices = Graph.GetChoices(NodeIndex);
+
+		// A node without choices ends through auto-advance
+		bool bIsExit = Choices.Num() == 0;
+
+		for (const FDialogueGraphChoice& Choice : Choices)
+		{
+			if (Choice.bEndsDialogue)
+			{
+				bIsExit = true;
+			}
+			else if (Choice.NextNodeIndex != INDEX_NONE)
+			{
+				IncomingEdges[Choice.NextNodeIndex].Add(NodeIndex);
+			}
+			else if (Choice.NextNodeTag.IsValid())
+			{
+				UE_LOG(LogTemp, Error, TEXT("DialogueGraphCommandlet: %s: %s has a choice to missing node %s"),
+					*TableName, *Node.RowName.ToString(), *Choice.NextNodeTag.ToString());
+				++Errors;
+				bIsExit = true;
+			}
+			else
+			{
+				UE_LOG(LogTemp, Error, TEXT("DialogueGraphCommandlet: %s: %s has choice \"%s\" that neither ends the dialogue nor leads anywhere"),
+					*TableName, *Node.RowName.ToString(), *Choice.ChoiceText.ToString());
+				++Errors;
+			}
+		}
+
+		if (bIsExit)
+		{
+			CanExit[NodeIndex] = true;
+			Pending.Add(NodeIndex);
+		}
+	}
+
+	// Walk edges backwards from the exits to find every node that can still end the conversation
+	while (Pending.Num() > 0)
+	{
+		const int32 NodeIndex = Pending.Pop(EAllowShrinking::No);
+		for (const int32 Source : IncomingEdges[NodeIndex])
+		{
+			if (!CanExit[Source])
+			{
+				CanExit[Source] = true;
+				Pending.Add(Source);
+			}
+		}
+	}
+
+	// Forward reachability from the NPC entry nodes
+	TBitArray<> Reachable(false, NumNodes);
+	for (const int32 EntryNode : EntryNodes)
+	{
+		Reachable[EntryNode] = true;
+		Pending.Add(EntryNode);
+	}
+	while (Pending.Num() > 0)
+	{
+		const int32 NodeIndex = Pending.Pop(EAllowShrinking::No);
+		for (const FDialogueGraphChoice& Choice : Graph.GetChoices(NodeIndex))
+		{
+			if (Choice.NextNodeIndex != INDEX_NONE && !Reachable[Choice.NextNodeIndex])
+			{
+				Reachable[Choice.NextNodeIndex] = true;
+				Pending.Add(Choice.NextNodeIndex);
+			}
+		}
+	}
+
+	int32 NumUnreachable = 0;
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+	{
+		const FName RowName = Graph.GetNode(NodeIndex).RowName;
+		if (!Reachable[NodeIndex])
+		{
+			UE_LOG(LogTemp, Warning, TEXT("DialogueGraphCommandlet: %s: %s is unreachable from any NPC entry node"), *TableName, *RowName.ToString());
+			++NumUnreachable;
+		}
+		else if (!CanExit[NodeIndex])
+		{
+			UE_LOG(LogTemp, Error, TEXT("DialogueGraphCommandlet: %s: %s is in a cycle without an exit"), *TableName, *RowName.ToString());
+			++Errors;
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("DialogueGraphCommandlet: %s: %d nodes, %d unreachable, %d error(s)"), *TableName, NumNodes, NumUnreachable, Errors);
+	return Errors;
+}
+
+void UDialogueGraphCommandlet::BenchmarkGraph(UDialogueGraph& Graph, const TArray<int32>& EntryNodes, int32 Iterations, int32 MaxSteps) const
+{
+	// Same node entry and choice evaluation the game runs, minus UI and audio
+	UDialogueComponent* DialogueComponent = NewObject<UDialogueComponent>(GetTransientPackage());
+	DialogueComponent->InitializeHeadless(&Graph);
+
+	FRandomStream RandomStream(1337);
+	int64 Advances = 0;
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (const int32 EntryNode : EntryNodes)
+		{
+			if (!DialogueComponent->EnterNode(EntryNode)) continue;
+			++Advances;
+
+			for (int32 Step = 0; Step < MaxSteps; ++Step)
+			{
+				const FDialogueChoiceSet& ValidChoices = DialogueComponent->GetValidChoices();
+				if (ValidChoices.IsEmpty()) break;
+
+				// Pick a random valid choice so every branch gets exercised over the iterations
+				int32 Remaining = RandomStream.RandHelper(ValidChoices.Num());
+				int32 PickedChoice = INDEX_NONE;
+				ValidChoices.ForEach([&Remaining, &PickedChoice](int32 ChoiceIndex)
+				{
+					if (Remaining-- == 0)
+					{
+						PickedChoice = ChoiceIndex;
+					}
+				});
+
+				const FDialogueGraphChoice& Choice = Graph.GetChoices(DialogueComponent->CurrentNodeIndex)[PickedChoice];
+				for (const FDialogueAction& Action : Graph.GetActions(Choice.FirstAction, Choice.NumActions))
+				{
+					DialogueComponent->ExecuteAction(Action);
+				}
+
+				if (Choice.bEndsDialogue || !DialogueComponent->EnterNode(Choice.NextNodeIndex)) break;
+				++Advances;
+			}
+		}
+	}
+	const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogTemp, Display, TEXT("DialogueGraphCommandlet: %s: %lld advances in %.3f ms, %.1f ns per advance"),
+		*GetNameSafe(Graph.GetSourceTable()), Advances, ElapsedSeconds * 1000.0,
+		Advances > 0 ? ElapsedSeconds * 1.0e9 / Advances : 0.0);
+}
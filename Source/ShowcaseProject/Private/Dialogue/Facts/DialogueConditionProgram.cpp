@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Dialogue/Facts/DialogueConditionProgram.h"
+
+#include "Dialogue/Facts/DialogueFactSubsystem.h"
+
+namespace
+{
+	FDialogueConditionOp MakeFactOp(EDialogueConditionOp Op, FGameplayTag FactTag, float Value, UDialogueFactSubsystem* Facts)
+	{
+		FDialogueConditionOp Result;
+		if (!FactTag.IsValid())
+		{
+			// Conditions without a fact to read have always failed
+			Result.Op = EDialogueConditionOp::AlwaysFalse;
+			return Result;
+		}
+
+		Result.Op = Op;
+		Result.FactSlot = Facts ? Facts->GetOrAddFactSlot(FactTag) : INDEX_NONE;
+		Result.Value = Value;
+		return Result;
+	}
+}
+
+FDialogueConditionOp FDialogueConditionOp::Compile(const FDialogueCondition& Condition, UDialogueFactSubsystem* Facts)
+{
+	static const FGameplayTag PlayerLevelFact = FGameplayTag::RequestGameplayTag(TEXT("Fact.Player.Level"), false);
+	static const FGameplayTag TimeOfDayFact = FGameplayTag::RequestGameplayTag(TEXT("Fact.World.TimeOfDay"), false);
+
+	FDialogueConditionOp Result;
+
+	switch (Condition.ConditionType)
+	{
+	case EDialogueConditionType::None:
+		Result.Op = EDialogueConditionOp::AlwaysTrue;
+		break;
+	case EDialogueConditionType::HasItem:
+		// ConditionTag is Fact.Item.<ItemID>, RequiredValue the count (at least one)
+		Result = MakeFactOp(EDialogueConditionOp::FactGreaterOrEqual, Condition.ConditionTag, FMath::Max(Condition.RequiredValue, 1.0f), Facts);
+		break;
+	case EDialogueConditionType::QuestStatus:
+		Result = MakeFactOp(EDialogueConditionOp::FactEqual, Condition.ConditionTag, Condition.RequiredValue, Facts);
+		break;
+	case EDialogueConditionType::FactionRelation:
+		Result = MakeFactOp(EDialogueConditionOp::FactGreaterOrEqual, Condition.ConditionTag, Condition.RequiredValue, Facts);
+		break;
+	case EDialogueConditionType::PlayerLevel:
+		Result = MakeFactOp(EDialogueConditionOp::FactGreaterOrEqual, Condition.ConditionTag.IsValid() ? Condition.ConditionTag : PlayerLevelFact, Condition.RequiredValue, Facts);
+		break;
+	case EDialogueConditionType::NPCHealth:
+		Result.Op = EDialogueConditionOp::NPCHealthGreaterOrEqual;
+		Result.Value = Condition.RequiredValue;
+		break;
+	case EDialogueConditionType::TimeOfDay:
+		Result = MakeFactOp(EDialogueConditionOp::FactGreaterOrEqual, Condition.ConditionTag.IsValid() ? Condition.ConditionTag : TimeOfDayFact, Condition.RequiredValue, Facts);
+		break;
+	case EDialogueConditionType::Custom:
+		// Custom conditions have no evaluator yet and keep passing
+		Result.Op = EDialogueConditionOp::AlwaysTrue;
+		break;
+	}
+
+	return Result;
+}
+
+bool FDialogueConditionOp::EvaluateAll(TConstArrayView<FDialogueConditionOp> Ops, const FDialogueConditionContext& Context)
+{
+	for (const FDialogueConditionOp& ConditionOp : Ops)
+	{
+		if (!ConditionOp.Evaluate(Context))
+		{
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,119 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Dialogue/Facts/DialogueFactSubsystem.h"
+
+#include "Components/InventoryComponent/InventoryComponent.h"
+#include "Items/ItemBase.h"
+
+void UDialogueFactSubsystem::Deinitialize()
+{
+	BindInventory(nullptr);
+	Super::Deinitialize();
+}
+
+int32 UDialogueFactSubsystem::GetOrAddFactSlot(FGameplayTag FactTag)
+{
+	if (!FactTag.IsValid()) return INDEX_NONE;
+
+	if (const int32* Existing = FactSlotByTag.Find(FactTag))
+	{
+		return *Existing;
+	}
+
+	const int32 Slot = FactValues.Add(0.0f);
+	FactTags.Add(FactTag);
+	FactSlotByTag.Add(FactTag, Slot);
+
+	// Item facts are named Fact.Item.<ItemID>, remember which ItemID they count
+	static const FGameplayTag ItemFactRoot = FGameplayTag::RequestGameplayTag(TEXT("Fact.Item"), false);
+	if (ItemFactRoot.IsValid() && FactTag.MatchesTag(ItemFactRoot) && FactTag != ItemFactRoot)
+	{
+		const FString TagString = FactTag.ToString();
+		const FString ItemID = TagString.RightChop(ItemFactRoot.ToString().Len() + 1);
+		ItemFactSlots.Add(FName(*ItemID), Slot);
+		RefreshInventoryFacts();
+	}
+
+	return Slot;
+}
+
+void UDialogueFactSubsystem::SetFact(FGameplayTag FactTag, float Value)
+{
+	const int32 Slot = GetOrAddFactSlot(FactTag);
+	if (Slot != INDEX_NONE)
+	{
+		SetFactSlot(Slot, Value);
+	}
+}
+
+void UDialogueFactSubsystem::AddToFact(FGameplayTag FactTag, float Delta)
+{
+	const int32 Slot = GetOrAddFactSlot(FactTag);
+	if (Slot != INDEX_NONE)
+	{
+		SetFactSlot(Slot, FactValues[Slot] + Delta);
+	}
+}
+
+float UDialogueFactSubsystem::GetFact(FGameplayTag FactTag) const
+{
+	const int32* Slot = FactSlotByTag.Find(FactTag);
+	return Slot ? FactValues[*Slot] : 0.0f;
+}
+
+void UDialogueFactSubsystem::SetFactSlot(int32 Slot, float Value)
+{
+	if (FactValues[Slot] == Value) return;
+
+	FactValues[Slot] = Value;
+	++FactsVersion;
+	OnFactChanged.Broadcast(FactTags[Slot], Value);
+}
+
+void UDialogueFactSubsystem::BindInventory(UInventoryComponent* Inventory)
+{
+	if (UInventoryComponent* PreviousInventory = BoundInventory.Get())
+	{
+		PreviousInventory->OnInventoryUpdated.Remove(InventoryUpdatedHandle);
+	}
+	InventoryUpdatedHandle.Reset();
+	BoundInventory = Inventory;
+
+	if (Inventory)
+	{
+		InventoryUpdatedHandle = Inventory->OnInventoryUpdated.AddUObject(this, &UDialogueFactSubsystem::RefreshInventoryFacts);
+	}
+	RefreshInventoryFacts();
+}
+
+void UDialogueFactSubsystem::RefreshInventoryFacts()
+{
+	if (ItemFactSlots.IsEmpty()) return;
+
+	// Recount only the items some condition asked about
+	TMap<int32, float> Counts;
+	Counts.Reserve(ItemFactSlots.Num());
+	for (const TPair<FName, int32>& ItemFact : ItemFactSlots)
+	{
+		Counts.Add(ItemFact.Value, 0.0f);
+	}
+
+	if (const UInventoryComponent* Inventory = BoundInventory.Get())
+	{
+		for (const UItemBase* Item : Inventory->GetInventoryContents())
+		{
+			if (!Item) continue;
+
+			if (const int32* Slot = ItemFactSlots.Find(Item->ItemID))
+			{
+				Counts[*Slot] += Item->Quantity;
+			}
+		}
+	}
+
+	for (const TPair<int32, float>& Count : Counts)
+	{
+		SetFactSlot(Count.Key, Count.Value);
+	}
+}
@@ -0,0 +1,177 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Dialogue/Graph/DialogueGraph.h"
+
+#include "Engine/DataTable.h"
+
+UDialogueGraph* UDialogueGraph::Compile(UDataTable* DialogueTable, UObject* Outer, UDialogueFactSubsystem* Facts)
+{
+	if (!DialogueTable || !DialogueTable->GetRowStruct() || !DialogueTable->GetRowStruct()->IsChildOf(FDialogueNode::StaticStruct()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("DialogueGraph: %s is not a dialogue table"), *GetNameSafe(DialogueTable));
+		return nullptr;
+	}
+
+	UDialogueGraph* Graph = NewObject<UDialogueGraph>(Outer);
+	Graph->SourceTable = DialogueTable;
+
+	const TMap<FName, uint8*>& RowMap = DialogueTable->GetRowMap();
+	Graph->Nodes.Reserve(RowMap.Num());
+	Graph->NodeData.Reserve(RowMap.Num());
+
+	// First pass: assign dense indices. Rows have always been looked up by a row name matching the tag,
+	// that mapping wins over the NodeTag field when the two disagree
+	for (const TPair<FName, uint8*>& Row : RowMap)
+	{
+		const FDialogueNode* SourceNode = reinterpret_cast<const FDialogueNode*>(Row.Value);
+		const int32 NodeIndex = Graph->Nodes.Num();
+
+		FDialogueGraphNode& Node = Graph->Nodes.AddDefaulted_GetRef();
+		Node.NodeTag = SourceNode->NodeTag;
+		Node.RowName = Row.Key;
+
+		const FGameplayTag RowTag = FGameplayTag::RequestGameplayTag(Row.Key, false);
+		if (RowTag.IsValid())
+		{
+			Graph->NodeIndexByTag.Add(RowTag, NodeIndex);
+		}
+		if (SourceNode->NodeTag.IsValid() && !Graph->NodeIndexByTag.Contains(SourceNode->NodeTag))
+		{
+			Graph->NodeIndexByTag.Add(SourceNode->NodeTag, NodeIndex);
+		}
+	}
+
+	// Second pass: flatten conditions/actions and resolve choice edges
+	int32 NodeIndex = 0;
+	for (const TPair<FName, uint8*>& Row : RowMap)
+	{
+		const FDialogueNode* SourceNode = reinterpret_cast<const FDialogueNode*>(Row.Value);
+		FDialogueGraphNode& Node = Graph->Nodes[NodeIndex++];
+
+		Node.FirstEntryCondition = Graph->Conditions.Num();
+		Node.NumEntryConditions = SourceNode->EntryConditions.Num();
+		Graph->Conditions.Append(SourceNode->EntryConditions);
+
+		Node.FirstEntryAction = Graph->Actions.Num();
+		Node.NumEntryActions = SourceNode->EntryActions.Num();
+		Graph->Actions.Append(SourceNode->EntryActions);
+
+		Node.FirstExitAction = Graph->Actions.Num();
+		Node.NumExitActions = SourceNode->ExitActions.Num();
+		Graph->Actions.Append(SourceNode->ExitActions);
+
+		// Choice sets are 64-bit masks, anything past that cannot be offered
+		if (SourceNode->Choices.Num() > FDialogueChoiceSet::MaxChoices)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("DialogueGraph: %s row %s has %d choices, only the first %d are used"),
+				*DialogueTable->GetName(), *Row.Key.ToString(), SourceNode->Choices.Num(), FDialogueChoiceSet::MaxChoices);
+		}
+
+		Node.FirstChoice = Graph->Choices.Num();
+		Node.NumChoices = FMath::Min(SourceNode->Choices.Num(), FDialogueChoiceSet::MaxChoices);
+		for (int32 ChoiceIndex = 0; ChoiceIndex < Node.NumChoices; ++ChoiceIndex)
+		{
+			const FDialogueChoice& SourceChoice = SourceNode->Choices[ChoiceIndex];
+			FDialogueGraphChoice& Choice = Graph->Choices.AddDefaulted_GetRef();
+			Choice.ChoiceText = SourceChoice.ChoiceText;
+			Choice.NextNodeTag = SourceChoice.NextNodeTag;
+			Choice.NextNodeIndex = Graph->FindNodeIndex(SourceChoice.NextNodeTag);
+			Choice.bEndsDialogue = SourceChoice.bEndsDialogue;
+
+			Choice.FirstCondition = Graph->Conditions.Num();
+			Choice.NumConditions = SourceChoice.Conditions.Num();
+			Graph->Conditions.Append(SourceChoice.Conditions);
+
+			Choice.FirstAction = Graph->Actions.Num();
+			Choice.NumActions = SourceChoice.Actions.Num();
+			Graph->Actions.Append(SourceChoice.Actions);
+
+			if (SourceChoice.NextNodeTag.IsValid() && Choice.NextNodeIndex == INDEX_NONE)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("DialogueGraph: %s row %s has a choice to missing node %s"),
+					*DialogueTable->GetName(), *Row.Key.ToString(), *SourceChoice.NextNodeTag.ToString());
+			}
+		}
+
+		// Keep only the presentation fields, the arrays above are the single copy
+		FDialogueNode& Data = Graph->NodeData.Add_GetRef(*SourceNode);
+		Data.Choices.Empty();
+		Data.EntryConditions.Empty();
+		Data.EntryActions.Empty();
+		Data.ExitActions.Empty();
+	}
+
+	Graph->ConditionOps.Reserve(Graph->Conditions.Num());
+	for (const FDialogueCondition& Condition : Graph->Conditions)
+	{
+		Graph->ConditionOps.Add(FDialogueConditionOp::Compile(Condition, Facts));
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("DialogueGraph: Compiled %s (%d nodes, %d choices)"), *DialogueTable->GetName(), Graph->Nodes.Num(), Graph->Choices.Num());
+
+	return Graph;
+}
+
+int32 UDialogueGraph::FindNodeIndex(FGameplayTag NodeTag) const
+{
+	if (!NodeTag.IsValid()) return INDEX_NONE;
+
+	const int32* Found = NodeIndexByTag.Find(NodeTag);
+	return Found ? *Found : INDEX_NONE;
+}
+
+TConstArrayView<FDialogueGraphChoice> UDialogueGraph::GetChoices(int32 NodeIndex) const
+{
+	if (!Nodes.IsValidIndex(NodeIndex)) return TConstArrayView<FDialogueGraphChoice>();
+
+	const FDialogueGraphNode& Node = Nodes[NodeIndex];
+	return TConstArrayView<FDialogueGraphChoice>(Choices.GetData() + Node.FirstChoice, Node.NumChoices);
+}
+
+TConstArrayView<FDialogueCondition> UDialogueGraph::GetConditions(int32 First, int32 Num) const
+{
+	return TConstArrayView<FDialogueCondition>(Conditions.GetData() + First, Num);
+}
+
+TConstArrayView<FDialogueConditionOp> UDialogueGraph::GetConditionOps(int32 First, int32 Num) const
+{
+	return TConstArrayView<FDialogueConditionOp>(ConditionOps.GetData() + First, Num);
+}
+
+TConstArrayView<FDialogueAction> UDialogueGraph::GetActions(int32 First, int32 Num) const
+{
+	return TConstArrayView<FDialogueAction>(Actions.GetData() + First, Num);
+}
+
+TConstArrayView<FDialogueCondition> UDialogueGraph::GetEntryConditions(int32 NodeIndex) const
+{
+	if (!Nodes.IsValidIndex(NodeIndex)) return TConstArrayView<FDialogueCondition>();
+
+	const FDialogueGraphNode& Node = Nodes[NodeIndex];
+	return GetConditions(Node.FirstEntryCondition, Node.NumEntryConditions);
+}
+
+TConstArrayView<FDialogueConditionOp> UDialogueGraph::GetEntryConditionOps(int32 NodeIndex) const
+{
+	if (!Nodes.IsValidIndex(NodeIndex)) return TConstArrayView<FDialogueConditionOp>();
+
+	const FDialogueGraphNode& Node = Nodes[NodeIndex];
+	return GetConditionOps(Node.FirstEntryCondition, Node.NumEntryConditions);
+}
+
+TConstArrayView<FDialogueAction> UDialogueGraph::GetEntryActions(int32 NodeIndex) const
+{
+	if (!Nodes.IsValidIndex(NodeIndex)) return TConstArrayView<FDialogueAction>();
+
+	const FDialogueGraphNode& Node = Nodes[NodeIndex];
+	return GetActions(Node.FirstEntryAction, Node.NumEntryActions);
+}
+
+TConstArrayView<FDialogueAction> UDialogueGraph::GetExitActions(int32 NodeIndex) const
+{
+	if (!Nodes.IsValidIndex(NodeIndex)) return TConstArrayView<FDialogueAction>();
+
+	const FDialogueGraphNode& Node = Nodes[NodeIndex];
+	return GetActions(Node.FirstExitAction, Node.NumExitActions);
+}
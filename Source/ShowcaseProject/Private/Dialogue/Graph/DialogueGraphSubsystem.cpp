@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Dialogue/Graph/DialogueGraphSubsystem.h"
+
+#include "Dialogue/Facts/DialogueFactSubsystem.h"
+#include "Dialogue/Graph/DialogueGraph.h"
+#include "Engine/DataTable.h"
+#include "Engine/GameInstance.h"
+
+void UDialogueGraphSubsystem::Deinitialize()
+{
+#if WITH_EDITOR
+	for (const TPair<TWeakObjectPtr<UDataTable>, FDelegateHandle>& Handle : TableChangedHandles)
+	{
+		if (UDataTable* Table = Handle.Key.Get())
+		{
+			Table->OnDataTableChanged().Remove(Handle.Value);
+		}
+	}
+	TableChangedHandles.Empty();
+#endif
+
+	CompiledGraphs.Empty();
+
+	Super::Deinitialize();
+}
+
+UDialogueGraph* UDialogueGraphSubsystem::GetOrCompileGraph(UDataTable* DialogueTable)
+{
+	if (!DialogueTable) return nullptr;
+
+	if (UDialogueGraph* const* Cached = CompiledGraphs.Find(DialogueTable))
+	{
+		return *Cached;
+	}
+
+	UDialogueGraph* Graph = UDialogueGraph::Compile(DialogueTable, this, GetGameInstance()->GetSubsystem<UDialogueFactSubsystem>());
+	if (!Graph) return nullptr;
+
+	CompiledGraphs.Add(DialogueTable, Graph);
+
+#if WITH_EDITOR
+	// Table edits during PIE recompile on next use
+	if (!TableChangedHandles.Contains(DialogueTable))
+	{
+		TWeakObjectPtr<UDataTable> WeakTable(DialogueTable);
+		TableChangedHandles.Add(DialogueTable, DialogueTable->OnDataTableChanged().AddWeakLambda(this, [this, WeakTable]()
+		{
+			InvalidateGraph(WeakTable.Get());
+		}));
+	}
+#endif
+
+	return Graph;
+}
+
+void UDialogueGraphSubsystem::InvalidateGraph(UDataTable* DialogueTable)
+{
+	if (DialogueTable && CompiledGraphs.Remove(DialogueTable) > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("DialogueGraphSubsystem: Invalidated graph for %s"), *DialogueTable->GetName());
+	}
+}
@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Framework/TimeDilation/TimeDilationSubsystem.h"
+
+#include "Curves/CurveFloat.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+
+void UTimeDilationSubsystem::PushTimeDilation(FName RequesterId, float TargetDilation, int32 Priority, float BlendTime, UCurveFloat* BlendCurve)
+{
+	FTimeDilationRequest* Request = Requests.FindByPredicate([RequesterId](const FTimeDilationRequest& Existing) { return Existing.RequesterId == RequesterId; });
+	if (!Request)
+	{
+		Request = &Requests.AddDefaulted_GetRef();
+		Request->RequesterId = RequesterId;
+	}
+
+	Request->TargetDilation = TargetDilation;
+	Request->Priority = Priority;
+	Request->Sequence = NextSequence++;
+
+	UE_LOG(LogTemp, Log, TEXT("TimeDilationSubsystem: %s requested %.2f (priority %d)"), *RequesterId.ToString(), TargetDilation, Priority);
+
+	StartBlend(BlendTime, BlendCurve);
+}
+
+void UTimeDilationSubsystem::PopTimeDilation(FName RequesterId, float BlendTime, UCurveFloat* BlendCurve)
+{
+	const int32 NumRemoved = Requests.RemoveAll([RequesterId](const FTimeDilationRequest& Existing) { return Existing.RequesterId == RequesterId; });
+	if (NumRemoved == 0) return;
+
+	UE_LOG(LogTemp, Log, TEXT("TimeDilationSubsystem: %s released its request"), *RequesterId.ToString());
+
+	StartBlend(BlendTime, BlendCurve);
+}
+
+bool UTimeDilationSubsystem::HasRequest(FName RequesterId) const
+{
+	return Requests.ContainsByPredicate([RequesterId](const FTimeDilationRequest& Existing) { return Existing.RequesterId == RequesterId; });
+}
+
+float UTimeDilationSubsystem::ResolveTargetDilation() const
+{
+	const FTimeDilationRequest* Winner = nullptr;
+	for (const FTimeDilationRequest& Request : Requests)
+	{
+		if (!Winner || Request.Priority > Winner->Priority || (Request.Priority == Winner->Priority && Request.Sequence > Winner->Sequence))
+		{
+			Winner = &Request;
+		}
+	}
+	return Winner ? Winner->TargetDilation : 1.0f;
+}
+
+void UTimeDilationSubsystem::StartBlend(float BlendTime, UCurveFloat* BlendCurve)
+{
+	const float NewTarget = ResolveTargetDilation();
+	if (!bIsBlending && FMath::IsNearlyEqual(NewTarget, AppliedDilation))
+	{
+		return;
+	}
+
+	// The actual SetGlobalTimeDilation happens in Tick, so several pushes in one frame still cost one update
+	BlendStartDilation = AppliedDilation;
+	BlendTargetDilation = NewTarget;
+	BlendStartRealTime = GetRealTimeSeconds();
+	BlendDuration = FMath::Max(BlendTime, 0.0f);
+	ActiveBlendCurve = BlendCurve;
+	bIsBlending = true;
+}
+
+void UTimeDilationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// DeltaTime is dilated, drive the blend from real time instead
+	const double Elapsed = GetRealTimeSeconds() - BlendStartRealTime;
+	const float Alpha = BlendDuration > 0.0f ? FMath::Clamp(static_cast<float>(Elapsed / BlendDuration), 0.0f, 1.0f) : 1.0f;
+	const float BlendAlpha = ActiveBlendCurve ? ActiveBlendCurve->GetFloatValue(Alpha) : FMath::InterpEaseOut(0.0f, 1.0f, Alpha, 2.0f);
+
+	const float NewDilation = Alpha >= 1.0f ? BlendTargetDilation : FMath::Lerp(BlendStartDilation, BlendTargetDilation, BlendAlpha);
+
+	if (!FMath::IsNearlyEqual(NewDilation, AppliedDilation, KINDA_SMALL_NUMBER))
+	{
+		AppliedDilation = NewDilation;
+		UGameplayStatics::SetGlobalTimeDilation(GetWorld(), AppliedDilation);
+	}
+
+	if (Alpha >= 1.0f)
+	{
+		bIsBlending = false;
+		ActiveBlendCurve = nullptr;
+	}
+}
+
+bool UTimeDilationSubsystem::IsTickable() const
+{
+	return bIsBlending;
+}
+
+TStatId UTimeDilationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTimeDilationSubsystem, STATGROUP_Tickables);
+}
+
+double UTimeDilationSubsystem::GetRealTimeSeconds() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetRealTimeSeconds() : 0.0;
+}
@@ -16,6 +16,24 @@ void UItemBase::ResetItemFlags()
 	bIsPickup = false;
 }
 
+UItemBase* UItemBase::CreateFromItemData(UObject* Outer, TSubclassOf<UItemBase> ItemClass, const FItemData& ItemData)
+{
+	UItemBase* Item = NewObject<UItemBase>(Outer, ItemClass ? ItemClass.Get() : UItemBase::StaticClass());
+
+	Item->ItemID = ItemData.ItemID;
+	Item->WeaponCategory = ItemData.WeaponCategory;
+	Item->ItemType = ItemData.ItemType;
+	Item->ItemQuality = ItemData.ItemQuality;
+	Item->ItemNumericData = ItemData.ItemNumericData;
+	Item->ItemTextData = ItemData.ItemTextData;
+	Item->ItemAssetData = ItemData.ItemAssetData;
+	Item->WeaponData = ItemData.WeaponData;
+	Item->AmmoData = ItemData.AmmoData;
+	Item->ItemStatistics = ItemData.ItemStatistics;
+
+	return Item;
+}
+
 UItemBase* UItemBase::CreateItemCopy() const
 {
 	UItemBase* ItemCopy = NewObject<UItemBase>(StaticClass());
@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NPC/Archetype/NPCArchetype.h"
+
+#include "String/Find.h"
+
+UNPCArchetype* UNPCArchetype::Build(const FST_NPCDataStruct& Row, FName RowName, UObject* Outer)
+{
+	UNPCArchetype* Archetype = NewObject<UNPCArchetype>(Outer);
+	Archetype->Data = Row;
+	Archetype->RowName = RowName;
+
+	Archetype->BoneMultiplierSubstrings.Reserve(Row.BoneDamageMultipliers.Num());
+	for (const TPair<FName, float>& Multiplier : Row.BoneDamageMultipliers)
+	{
+		Archetype->BoneMultiplierSubstrings.Emplace(Multiplier.Key.ToString(), Multiplier.Value);
+	}
+
+	return Archetype;
+}
+
+float UNPCArchetype::GetBoneDamageMultiplier(FName BoneName) const
+{
+	if (BoneName == NAME_None) return 1.0f;
+
+	if (const float* Multiplier = Data.BoneDamageMultipliers.Find(BoneName))
+	{
+		return *Multiplier;
+	}
+
+	// Check for partial bone name matches
+	const FNameBuilder BoneString(BoneName);
+	for (const TPair<FString, float>& Multiplier : BoneMultiplierSubstrings)
+	{
+		if (UE::String::FindFirst(BoneString.ToView(), Multiplier.Key, ESearchCase::IgnoreCase) != INDEX_NONE)
+		{
+			return Multiplier.Value;
+		}
+	}
+
+	return 1.0f;
+}
@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NPC/Archetype/NPCArchetypeSubsystem.h"
+
+#include "Data/FST_NPCDataStruct.h"
+#include "NPC/Archetype/NPCArchetype.h"
+
+void UNPCArchetypeSubsystem::Deinitialize()
+{
+#if WITH_EDITOR
+	for (const TPair<TWeakObjectPtr<UDataTable>, FDelegateHandle>& Handle : TableChangedHandles)
+	{
+		if (UDataTable* Table = Handle.Key.Get())
+		{
+			Table->OnDataTableChanged().Remove(Handle.Value);
+		}
+	}
+	TableChangedHandles.Empty();
+#endif
+
+	Tables.Empty();
+	DefaultArchetype = nullptr;
+
+	Super::Deinitialize();
+}
+
+const UNPCArchetype* UNPCArchetypeSubsystem::GetOrCreateArchetype(const FDataTableRowHandle& RowHandle)
+{
+	UDataTable* DataTable = const_cast<UDataTable*>(RowHandle.DataTable.Get());
+	if (!DataTable || RowHandle.RowName == NAME_None) return nullptr;
+
+	FNPCArchetypeTable& Table = Tables.FindOrAdd(DataTable);
+	if (UNPCArchetype* const* Cached = Table.Rows.Find(RowHandle.RowName))
+	{
+		return *Cached;
+	}
+
+	const FST_NPCDataStruct* Row = DataTable->FindRow<FST_NPCDataStruct>(RowHandle.RowName, TEXT("NPCArchetypeSubsystem"));
+	if (!Row) return nullptr;
+
+	UNPCArchetype* Archetype = UNPCArchetype::Build(*Row, RowHandle.RowName, this);
+	Table.Rows.Add(RowHandle.RowName, Archetype);
+
+#if WITH_EDITOR
+	// Row edits during PIE apply to NPCs spawned afterwards
+	if (!TableChangedHandles.Contains(DataTable))
+	{
+		TWeakObjectPtr<UDataTable> WeakTable(DataTable);
+		TableChangedHandles.Add(DataTable, DataTable->OnDataTableChanged().AddWeakLambda(this, [this, WeakTable]()
+		{
+			InvalidateTable(WeakTable.Get());
+		}));
+	}
+#endif
+
+	return Archetype;
+}
+
+const UNPCArchetype* UNPCArchetypeSubsystem::GetDefaultArchetype()
+{
+	if (!DefaultArchetype)
+	{
+		DefaultArchetype = UNPCArchetype::Build(FST_NPCDataStruct(), NAME_None, this);
+	}
+	return DefaultArchetype;
+}
+
+void UNPCArchetypeSubsystem::InvalidateTable(UDataTable* DataTable)
+{
+	if (DataTable && Tables.Remove(DataTable) > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("NPCArchetypeSubsystem: Invalidated archetypes for %s"), *DataTable->GetName());
+	}
+}
@@ -8,6 +8,15 @@
 #include "NPC/Controller/NPC_AIController.h"
 #include "Player/ShowcaseProjectCharacter.h"
 #include "Components/DialogueComponent/DialogueComponent.h"
+#include "Dialogue/Barks/DialogueBarkSubsystem.h"
+#include "NPC/Crowd/NPCCrowdSubsystem.h"
+#include "NPC/Ragdoll/NPCRagdollSubsystem.h"
+#include "NPC/Simulation/NPCSimulationSubsystem.h"
+#include "NPC/SmartObject/ShowcaseSmartObjectSubsystem.h"
+#include "NPC/Spawning/NPCSpawnerSubsystem.h"
+#include "NPC/Archetype/NPCArchetype.h"
+#include "NPC/Archetype/NPCArchetypeSubsystem.h"
+#include "Engine/GameInstance.h"
 #include "GameFramework/CharacterMovementComponent.h"
 
 // Sets default values
@@ -26,21 +35,8 @@ ANPC_BaseCharacter::ANPC_BaseCharacter()
 	DeathDelayTime = 5.0f;
 	RagdollImpulseStrength = 500.0f;
 	bCanRagdoll = true;
-
-	// Set default bone damage multipliers if not already set
-	if (BoneDamageMultipliers.Num() == 0)
-	{
-		BoneDamageMultipliers.Add(TEXT("head"), 2.0f);
-		BoneDamageMultipliers.Add(TEXT("Head"), 2.0f);
-		BoneDamageMultipliers.Add(TEXT("skull"), 2.0f);
-		BoneDamageMultipliers.Add(TEXT("spine_03"), 1.5f);
-		BoneDamageMultipliers.Add(TEXT("spine_02"), 1.2f);
-		BoneDamageMultipliers.Add(TEXT("spine_01"), 1.0f);
-	}
     
 	// Initialize internal state
-	CurrentAlertness = 0.0f;
-	TimeInCurrentState = 0.0f;
 	CurrentTarget = nullptr;
 	LastKnownPlayerLocation = nullptr;
 }
@@ -73,6 +69,9 @@ void ANPC_BaseCharacter::BeginPlay()
 		// Enable complex collision for accurate bone hit detection
 		MeshComp->SetCollisionResponseToChannel(ECC_Visibility, ECR_Block);
 		MeshComp->SetCanEverAffectNavigation(false);
+
+		DefaultMeshRelativeTransform = MeshComp->GetRelativeTransform();
+		DefaultMeshCameraResponse = MeshComp->GetCollisionResponseToChannel(ECC_Camera);
 	}
 
 	
@@ -82,9 +81,39 @@ void ANPC_BaseCharacter::BeginPlay()
 		MaxHealth = 100.0f;
 	}
 	CurrentHealth = MaxHealth;
+
+	if (UNPCSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UNPCSimulationSubsystem>())
+	{
+		Simulation->RegisterNPC(this);
+	}
     
 	// Set initial state
 	SetNPCState(ENPCState::Idle);
+
+	if (UNPCSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UNPCSignificanceSubsystem>())
+	{
+		SignificanceSubsystem->RegisterNPC(this);
+	}
+}
+
+void ANPC_BaseCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UNPCRagdollSubsystem* Ragdolls = GetWorld()->GetSubsystem<UNPCRagdollSubsystem>())
+	{
+		Ragdolls->ReleaseRagdoll(this);
+	}
+
+	if (UNPCSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UNPCSignificanceSubsystem>())
+	{
+		SignificanceSubsystem->UnregisterNPC(this);
+	}
+
+	if (UNPCSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UNPCSimulationSubsystem>())
+	{
+		Simulation->UnregisterNPC(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ANPC_BaseCharacter::BeginDestroy()
@@ -97,6 +126,40 @@ void ANPC_BaseCharacter::OnStateChanged(ENPCState OldState, ENPCState NewState)
 	return;
 }
 
+void ANPC_BaseCharacter::ApplySignificance(ENPCSignificance NewSignificance)
+{
+	Significance = NewSignificance;
+	const FNPCSignificanceSettings& Settings = FNPCSignificanceSettings::Get(NewSignificance);
+
+	SetActorTickInterval(Settings.ActorTickInterval);
+
+	if (USkeletalMeshComponent* MeshComp = GetMesh())
+	{
+		MeshComp->SetComponentTickInterval(Settings.AnimationTickInterval);
+		MeshComp->bEnableUpdateRateOptimizations = Settings.bEnableUpdateRateOptimizations;
+		MeshComp->VisibilityBasedAnimTickOption = Settings.VisibilityBasedAnimTickOption;
+	}
+
+	if (StateTreeComponent)
+	{
+		StateTreeComponent->SetComponentTickInterval(Settings.StateTreeTickInterval);
+	}
+
+	if (ANPC_AIController* AIController = Cast<ANPC_AIController>(GetController()))
+	{
+		AIController->ApplySignificance(Settings);
+	}
+
+	// Far enough out the crowd may take over entirely
+	if (NewSignificance == ENPCSignificance::Dormant)
+	{
+		if (UNPCCrowdSubsystem* Crowd = GetWorld()->GetSubsystem<UNPCCrowdSubsystem>())
+		{
+			Crowd->RequestDemotion(this);
+		}
+	}
+}
+
 // Called every frame
 void ANPC_BaseCharacter::Tick(float DeltaTime)
 {
@@ -112,15 +175,20 @@ void ANPC_BaseCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputC
 
 void ANPC_BaseCharacter::InitializeFromDataTable()
 {
+	UNPCArchetypeSubsystem* Archetypes = GetGameInstance() ? GetGameInstance()->GetSubsystem<UNPCArchetypeSubsystem>() : nullptr;
+	if (!Archetypes) return;
+
+	// Without a row the NPC still shares the default archetype, so the bone multipliers apply
+	Archetype = Archetypes->GetDefaultArchetype();
+
 	if (NPCDataHandle.DataTable && NPCDataHandle.RowName != NAME_None)
 	{
-		FST_NPCDataStruct* RowData = NPCDataHandle.DataTable->FindRow<FST_NPCDataStruct>(NPCDataHandle.RowName, TEXT(""));
-		if (RowData)
+		if (const UNPCArchetype* RowArchetype = Archetypes->GetOrCreateArchetype(NPCDataHandle))
 		{
-			NPCData = *RowData;
+			Archetype = RowArchetype;
 
 			//Apply data from the table
-			MaxHealth = NPCData.MaxHealth;
+			MaxHealth = Archetype->GetData().MaxHealth;
 			CurrentHealth = MaxHealth;
 
 			//Update movement speeds
@@ -137,6 +205,12 @@ void ANPC_BaseCharacter::InitializeFromDataTable()
 	}
 }
 
+const FST_NPCDataStruct& ANPC_BaseCharacter::GetNPCData() const
+{
+	static const FST_NPCDataStruct DefaultNPCData;
+	return Archetype ? Archetype->GetData() : DefaultNPCData;
+}
+
 void ANPC_BaseCharacter::SetNPCState(ENPCState NewState)
 {
 	if (CurrentState != NewState)
@@ -144,7 +218,11 @@ void ANPC_BaseCharacter::SetNPCState(ENPCState NewState)
 		ENPCState OldState = CurrentState;
 		PreviousState = CurrentState;
 		CurrentState = NewState;
-		TimeInCurrentState = 0.0f;
+
+		if (UNPCSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UNPCSimulationSubsystem>())
+		{
+			Simulation->NotifyStateChanged(this);
+		}
 
 		OnStateChanged(OldState, NewState);
 
@@ -170,7 +248,7 @@ void ANPC_BaseCharacter::StartDialogue(AActor* DialoguePartner)
 {
 	if (DialogueComponent)
 	{
-		DialogueComponent->StartDialogue(DialoguePartner, NPCData.InitialDialogueNode);
+		DialogueComponent->StartDialogue(DialoguePartner, GetNPCData().InitialDialogueNode);
 	}
 }
 
@@ -182,8 +260,90 @@ void ANPC_BaseCharacter::EndDialogue()
 	}
 }
 
+void ANPC_BaseCharacter::NotifyWeaponSpotted(AActor* WeaponHolder, bool bIsDrawn, float ReactionIntensity)
+{
+	OnWeaponSpotted.Broadcast(WeaponHolder, bIsDrawn, ReactionIntensity);
+	RaiseAlertness(ReactionIntensity);
+
+	if (bIsDrawn && !bIsDead && CurrentState != ENPCState::Combat)
+	{
+		if (UDialogueBarkSubsystem* Barks = GetWorld()->GetSubsystem<UDialogueBarkSubsystem>())
+		{
+			static const FGameplayTag WeaponSpottedBark = FGameplayTag::RequestGameplayTag(TEXT("Bark.WeaponSpotted"), false);
+			Barks->RequestBark(this, WeaponSpottedBark, EBarkPriority::Reaction);
+		}
+	}
+}
+
+float ANPC_BaseCharacter::GetAlertness() const
+{
+	const UNPCSimulationSubsystem* Simulation = GetWorld() ? GetWorld()->GetSubsystem<UNPCSimulationSubsystem>() : nullptr;
+	return Simulation ? Simulation->GetAlertness(this) : 0.0f;
+}
+
+float ANPC_BaseCharacter::GetTimeInCurrentState() const
+{
+	const UNPCSimulationSubsystem* Simulation = GetWorld() ? GetWorld()->GetSubsystem<UNPCSimulationSubsystem>() : nullptr;
+	return Simulation ? Simulation->GetTimeInState(this) : 0.0f;
+}
+
+void ANPC_BaseCharacter::RaiseAlertness(float Amount)
+{
+	if (UNPCSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UNPCSimulationSubsystem>())
+	{
+		Simulation->RaiseAlertness(this, Amount);
+	}
+}
+
+void ANPC_BaseCharacter::OnAlertnessCalmed()
+{
+	// Nothing turned up, back to what it was doing
+	if (CurrentState == ENPCState::Alert)
+	{
+		SetNPCState(PreviousState == ENPCState::Patrol ? ENPCState::Patrol : ENPCState::Idle);
+	}
+}
+
+void ANPC_BaseCharacter::ApplyRegeneratedHealth(float Health)
+{
+	if (!IsAlive()) return;
+
+	CurrentHealth = FMath::Clamp(Health, CurrentHealth, MaxHealth);
+}
+
 // InteractionInterface functions
 
+bool ANPC_BaseCharacter::ShouldTakeCover() const
+{
+	return GetNPCData().bCanTakeCover && IsAlive() && MaxHealth > 0.0f
+		&& CurrentHealth / MaxHealth <= GetNPCData().TakeCoverHealthThreshold;
+}
+
+bool ANPC_BaseCharacter::FindCoverFrom(AActor* Threat, FNPCCoverResult& OutCover)
+{
+	if (!Threat || !GetNPCData().bCanTakeCover) return false;
+
+	UNPCCoverSubsystem* Cover = GetWorld()->GetSubsystem<UNPCCoverSubsystem>();
+	if (!Cover) return false;
+
+	FVector ThreatEyes;
+	FRotator ThreatRotation;
+	Threat->GetActorEyesViewPoint(ThreatEyes, ThreatRotation);
+
+	if (!Cover->FindBestCover(this, ThreatEyes, Threat, CoverSearchRadius, OutCover)) return false;
+
+	Cover->ClaimCover(OutCover, this);
+	return true;
+}
+
+void ANPC_BaseCharacter::ReleaseCover()
+{
+	if (UNPCCoverSubsystem* Cover = GetWorld()->GetSubsystem<UNPCCoverSubsystem>())
+	{
+		Cover->ReleaseCover(this);
+	}
+}
+
 void ANPC_BaseCharacter::BeginFocus()
 {
 	UE_LOG(LogTemp, Log, TEXT("NPC %s is focused"), *GetName());
@@ -291,6 +451,21 @@ float ANPC_BaseCharacter::TakeDamage(float DamageAmount, const FDamageEvent& Dam
 		Die(DamageEvent, EventInstigator, DamageCauser);
 	}
 
+	if (!bIsDead)
+	{
+		if (UNPCSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UNPCSimulationSubsystem>())
+		{
+			Simulation->NotifyDamaged(this);
+			Simulation->RaiseAlertness(this, 1.0f);
+		}
+
+		if (UDialogueBarkSubsystem* Barks = GetWorld()->GetSubsystem<UDialogueBarkSubsystem>())
+		{
+			static const FGameplayTag DamageBark = FGameplayTag::RequestGameplayTag(TEXT("Bark.Damage"), false);
+			Barks->RequestBark(this, DamageBark, EBarkPriority::Combat);
+		}
+	}
+
 	// Set combat state if not already dead
 	if (!bIsDead && CurrentState != ENPCState::Combat)
 	{
@@ -326,20 +501,32 @@ void ANPC_BaseCharacter::Die(const FDamageEvent& DamageEvent, AController* Event
 
 	//Trigger death events
 	OnDeathDelegate.Broadcast(DamageCauser, DamageEvent);
+
+	// Free any bench, chair or cover point right away instead of waiting for a sweep
+	if (UShowcaseSmartObjectSubsystem* SmartObjects = GetWorld()->GetSubsystem<UShowcaseSmartObjectSubsystem>())
+	{
+		SmartObjects->ReleaseClaimsForUser(this);
+	}
+	ReleaseCover();
+
 	//Enable ragdoll physics
 	if (ShouldRagdollOnDeath() && bCanRagdoll)
 	{
-		EnableRagdoll(ImpulseLocation, ImpulseDirection);
+		if (UNPCRagdollSubsystem* Ragdolls = GetWorld()->GetSubsystem<UNPCRagdollSubsystem>())
+		{
+			Ragdolls->RequestRagdoll(this, ImpulseLocation, ImpulseDirection);
+		}
+		else
+		{
+			EnableRagdoll(ImpulseLocation, ImpulseDirection);
+		}
 	}
 
-	//Set cleanup timer
-	GetWorldTimerManager().SetTimer(
-		DeathCleanupTimer,
-		this,
-		&ANPC_BaseCharacter::CleanupAfterDeath,
-		DeathDelayTime,
-		false
-		);
+	//Schedule cleanup
+	if (UNPCSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UNPCSimulationSubsystem>())
+	{
+		Simulation->ScheduleCleanup(this, DeathDelayTime);
+	}
 }
 
 
@@ -362,6 +549,47 @@ void ANPC_BaseCharacter::EnableRagdoll(const FVector& ImpulseLocation, const FVe
 	UE_LOG(LogTemp, Log, TEXT("%s enabled ragdoll physics"), *GetName());
 }
 
+void ANPC_BaseCharacter::FreezeRagdollPose()
+{
+	USkeletalMeshComponent* MeshComp = GetMesh();
+	if (!MeshComp) return;
+
+	// The bone transforms keep the last simulated pose as long as nothing refreshes them
+	MeshComp->SetSimulatePhysics(false);
+	MeshComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	MeshComp->bPauseAnims = true;
+	MeshComp->bNoSkeletonUpdate = true;
+	MeshComp->SetComponentTickEnabled(false);
+}
+
+void ANPC_BaseCharacter::ResetRagdoll()
+{
+	USkeletalMeshComponent* MeshComp = GetMesh();
+	if (!MeshComp) return;
+
+	MeshComp->SetSimulatePhysics(false);
+	MeshComp->bPauseAnims = false;
+	MeshComp->bNoSkeletonUpdate = false;
+	MeshComp->SetComponentTickEnabled(true);
+
+	// Simulating detached the mesh from the capsule
+	MeshComp->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	MeshComp->SetRelativeTransform(DefaultMeshRelativeTransform);
+
+	MeshComp->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	MeshComp->SetCollisionResponseToChannel(ECC_Pawn, ECR_Block);
+	MeshComp->SetCollisionResponseToChannel(ECC_Camera, DefaultMeshCameraResponse);
+}
+
+void ANPC_BaseCharacter::RecycleCorpse()
+{
+	if (UNPCSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UNPCSimulationSubsystem>())
+	{
+		Simulation->CancelCleanup(this);
+	}
+	CleanupAfterDeath();
+}
+
 void ANPC_BaseCharacter::ApplyDeathImpulse(const FVector& ImpulseLocation, const FVector& ImpulseDirection)
 {
 	if (!GetMesh() || ImpulseDirection.IsZero()) return;
@@ -438,27 +666,135 @@ void ANPC_BaseCharacter::CleanupAfterDeath()
 	UE_LOG(LogTemp, Log, TEXT("Cleaning up dead NPC: %s"), *GetName());
     
 	// Add any cleanup logic here (drop items, etc.)
-	// For now, just destroy the actor
+	// Back to the pool, the next spawn of this type reuses the actor
+	if (UNPCSpawnerSubsystem* Spawner = GetWorld()->GetSubsystem<UNPCSpawnerSubsystem>())
+	{
+		Spawner->ReleaseNPC(this);
+		return;
+	}
+
 	Destroy();
 }
 
-float ANPC_BaseCharacter::GetDamageMultiplier(const FDamageEvent& DamageEvent, const FName& BoneName) const
+void ANPC_BaseCharacter::DeactivateForPool()
 {
-	if (BoneName != NAME_None && BoneDamageMultipliers.Contains(BoneName))
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+
+	if (UNPCRagdollSubsystem* Ragdolls = GetWorld()->GetSubsystem<UNPCRagdollSubsystem>())
 	{
-		return BoneDamageMultipliers[BoneName];
+		Ragdolls->ReleaseRagdoll(this);
 	}
 
-	// Check for partial bone name matches
-	for (const auto& BoneMultiplier : BoneDamageMultipliers)
+	// Whether the body was simulating, frozen or ragdolled without the subsystem, the next life starts on a clean mesh
+	ResetRagdoll();
+
+	if (UNPCSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UNPCSignificanceSubsystem>())
 	{
-		if (BoneName.ToString().Contains(BoneMultiplier.Key.ToString()))
+		SignificanceSubsystem->UnregisterNPC(this);
+	}
+
+	if (UNPCSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UNPCSimulationSubsystem>())
+	{
+		Simulation->UnregisterNPC(this);
+	}
+
+	if (UShowcaseSmartObjectSubsystem* SmartObjects = GetWorld()->GetSubsystem<UShowcaseSmartObjectSubsystem>())
+	{
+		SmartObjects->ReleaseClaimsForUser(this);
+	}
+	ReleaseCover();
+
+	if (StateTreeComponent)
+	{
+		StateTreeComponent->StopLogic(TEXT("NPC pooled"));
+	}
+
+	// The controller stays alive, unpossessed it drops out of the perception grid
+	if (AController* CurrentController = GetController())
+	{
+		if (AAIController* AIController = Cast<AAIController>(CurrentController))
+		{
+			AIController->StopMovement();
+		}
+
+		// Out of the grid nothing would ever tell it the targets it saw are gone
+		if (ANPC_AIController* NPCController = Cast<ANPC_AIController>(CurrentController))
+		{
+			NPCController->ForgetSeenTargets();
+		}
+		PooledController = CurrentController;
+		CurrentController->UnPossess();
+	}
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->DisableMovement();
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+}
+
+void ANPC_BaseCharacter::ResetForRespawn(const FTransform& SpawnTransform)
+{
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+
+	// Mutable state back to what BeginPlay gives a fresh NPC
+	bIsDead = false;
+	CurrentHealth = MaxHealth;
+	CurrentTarget = nullptr;
+	LastKnownPlayerLocation = nullptr;
+	bIsInDialogue = false;
+
+	// Registering again starts alertness and time in state from zero
+	if (UNPCSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UNPCSimulationSubsystem>())
+	{
+		Simulation->RegisterNPC(this);
+	}
+	SetNPCState(ENPCState::Idle);
+
+	if (UNPCSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UNPCSignificanceSubsystem>())
+	{
+		SignificanceSubsystem->RegisterNPC(this);
+	}
+
+	if (IsValid(PooledController))
+	{
+		PooledController->Possess(this);
+	}
+	else
+	{
+		SpawnDefaultController();
+	}
+	PooledController = nullptr;
+
+	if (StateTreeComponent)
+	{
+		StateTreeComponent->RestartLogic();
+	}
+
+	// Death stopped the controller's brain
+	if (AAIController* AIController = Cast<AAIController>(GetController()))
+	{
+		UBrainComponent* Brain = AIController->GetBrainComponent();
+		if (Brain && Brain != StateTreeComponent)
 		{
-			return BoneMultiplier.Value;
+			Brain->RestartLogic();
 		}
 	}
+}
 
-	return 1.0f; // Default multiplier
+float ANPC_BaseCharacter::GetDamageMultiplier(const FDamageEvent& DamageEvent, const FName& BoneName) const
+{
+	return Archetype ? Archetype->GetBoneDamageMultiplier(BoneName) : 1.0f;
 }
 
 
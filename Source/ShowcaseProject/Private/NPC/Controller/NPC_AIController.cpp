@@ -8,6 +8,9 @@
 #include "Perception/AIPerceptionComponent.h"
 #include "Perception/AISenseConfig_Sight.h"
 #include "Perception/AISenseConfig_Hearing.h"
+#include "NPC/Perception/NPCPerceptionSubsystem.h"
+#include "Components/WeaponSystemComponent/WeaponSystemComponent.h"
+#include "Player/ShowcaseProjectCharacter.h"
 
 ANPC_AIController::ANPC_AIController(FObjectInitializer const& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -27,6 +30,72 @@ void ANPC_AIController::BeginPlay()
 	{
 		PossessedNPCCharacter = Cast<ANPC_BaseCharacter>(GetPawn());
 	}
+
+	if (UNPCPerceptionSubsystem* Perception = GetWorld()->GetSubsystem<UNPCPerceptionSubsystem>())
+	{
+		SightListenerId = Perception->RegisterListener(this, SightConfig->SightRadius, SightConfig->LoseSightRadius,
+			SightConfig->PeripheralVisionAngleDegrees, HearingConfig->HearingRange);
+	}
+}
+
+void ANPC_AIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UNPCPerceptionSubsystem* Perception = GetWorld()->GetSubsystem<UNPCPerceptionSubsystem>())
+	{
+		Perception->UnregisterListener(SightListenerId);
+	}
+	SightListenerId = INDEX_NONE;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ANPC_AIController::HandleSightUpdated(AActor* Target, bool bIsSeen)
+{
+	if (bIsSeen)
+	{
+		SeenActors.AddUnique(Target);
+	}
+	else
+	{
+		SeenActors.RemoveSingleSwap(Target);
+	}
+
+	OnSightUpdated.Broadcast(Target, bIsSeen);
+
+	if (!bIsSeen || !PossessedNPCCharacter) return;
+
+	const AShowcaseProjectCharacter* Player = Cast<AShowcaseProjectCharacter>(Target);
+	const UWeaponSystemComponent* WeaponSystem = Player ? Player->GetWeaponSystem() : nullptr;
+	if (WeaponSystem && WeaponSystem->GetEquippedWeapon())
+	{
+		PossessedNPCCharacter->NotifyWeaponSpotted(Target, true, 1.0f);
+	}
+}
+
+void ANPC_AIController::ForgetSeenTargets()
+{
+	if (UNPCPerceptionSubsystem* Perception = GetWorld()->GetSubsystem<UNPCPerceptionSubsystem>())
+	{
+		Perception->ForgetSeenTargets(SightListenerId);
+	}
+}
+
+void ANPC_AIController::HandleNoiseHeard(const FVector& NoiseLocation, AActor* NoiseInstigator, FName NoiseTag)
+{
+	LastHeardNoiseLocation = NoiseLocation;
+	OnNoiseHeard.Broadcast(NoiseLocation, NoiseInstigator, NoiseTag);
+
+	// Calm NPCs go looking, anyone already reacting keeps what they are doing
+	if (PossessedNPCCharacter && PossessedNPCCharacter->IsAlive())
+	{
+		PossessedNPCCharacter->RaiseAlertness(NoiseAlertness);
+
+		const ENPCState State = PossessedNPCCharacter->GetCurrentState();
+		if (State == ENPCState::Idle || State == ENPCState::Patrol)
+		{
+			PossessedNPCCharacter->SetNPCState(ENPCState::Alert);
+		}
+	}
 }
 
 void ANPC_AIController::OnPossess(APawn* InPawn)
@@ -34,7 +103,17 @@ void ANPC_AIController::OnPossess(APawn* InPawn)
 	Super::OnPossess(InPawn);
 
 	PossessedNPCCharacter = Cast<ANPC_BaseCharacter>(InPawn);
-    
+
+	// Pick up the budget the pawn already has
+	if (PossessedNPCCharacter)
+	{
+		ApplySignificance(FNPCSignificanceSettings::Get(PossessedNPCCharacter->GetSignificance()));
+	}
+}
+
+void ANPC_AIController::ApplySignificance(const FNPCSignificanceSettings& Settings)
+{
+	SetActorTickInterval(Settings.ControllerTickInterval);
 }
 
 void ANPC_AIController::Tick(float DeltaSeconds)
@@ -61,12 +140,12 @@ void ANPC_AIController::SetupPerceptionSystem()
 		HearingConfig->DetectionByAffiliation.bDetectNeutrals = true;
 		HearingConfig->DetectionByAffiliation.bDetectFriendlies = true;
 
-		// Register the sight sense to our perception component
+		// Sight and gameplay noises are shared through the NPC perception and noise subsystems, the hearing sense
+		// only picks up engine MakeNoise reports
 		if (AIPerceptionComponent)
 		{
-			AIPerceptionComponent->ConfigureSense(*SightConfig);
 			AIPerceptionComponent->ConfigureSense(*HearingConfig);
-			AIPerceptionComponent->SetDominantSense(SightConfig->GetSenseImplementation());
+			AIPerceptionComponent->SetDominantSense(HearingConfig->GetSenseImplementation());
 		}
 	}
 }
@@ -0,0 +1,162 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NPC/Cover/Commandlets/NPCCoverBakeCommandlet.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Misc/PackageName.h"
+#include "NavigationSystem.h"
+#include "NPC/Cover/NPCCoverData.h"
+#include "UObject/SavePackage.h"
+
+UNPCCoverBakeCommandlet::UNPCCoverBakeCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UNPCCoverBakeCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	const bool bSave = !FParse::Param(*Params, TEXT("NoSave"));
+
+	TArray<FString> MapPackages;
+	GatherMaps(Params, MapPackages);
+
+	UE_LOG(LogTemp, Display, TEXT("NPCCoverBakeCommandlet: Baking cover for %d maps"), MapPackages.Num());
+
+	int32 NumFailed = 0;
+	for (const FString& MapPackage : MapPackages)
+	{
+		if (!BakeMap(MapPackage, bSave))
+		{
+			++NumFailed;
+		}
+
+		// Each map is loaded on its own, drop the previous one before the next
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("NPCCoverBakeCommandlet: Finished, %d map(s) failed"), NumFailed);
+	return NumFailed > 0 ? 1 : 0;
+#else
+	UE_LOG(LogTemp, Error, TEXT("NPCCoverBakeCommandlet: Baking needs an editor build"));
+	return 1;
+#endif
+}
+
+void UNPCCoverBakeCommandlet::GatherMaps(const FString& Params, TArray<FString>& OutMapPackages) const
+{
+	FString MapsValue;
+	if (FParse::Value(*Params, TEXT("Maps="), MapsValue, false))
+	{
+		MapsValue.ParseIntoArray(OutMapPackages, TEXT("+"));
+		return;
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> MapAssets;
+	AssetRegistry.GetAssetsByClass(UWorld::StaticClass()->GetClassPathName(), MapAssets);
+
+	for (const FAssetData& MapAsset : MapAssets)
+	{
+		const FString PackageName = MapAsset.PackageName.ToString();
+		if (PackageName.StartsWith(TEXT("/Game/")))
+		{
+			OutMapPackages.Add(PackageName);
+		}
+	}
+}
+
+bool UNPCCoverBakeCommandlet::BakeMap(const FString& MapPackage, bool bSave) const
+{
+	UPackage* Package = LoadPackage(nullptr, *MapPackage, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("NPCCoverBakeCommandlet: %s could not be loaded"), *MapPackage);
+		return false;
+	}
+
+	World->WorldType = EWorldType::Editor;
+	World->AddToRoot();
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld(UWorld::InitializationValues()
+			.AllowAudioPlayback(false)
+			.RequiresHitProxies(false)
+			.CreatePhysicsScene(true)
+			.ShouldSimulatePhysics(false)
+			.EnableTraceCollision(true)
+			.CreateNavigation(true)
+			.CreateAISystem(false)
+			.SetTransactional(false));
+	}
+	World->UpdateWorldComponents(true, false);
+
+	if (World->IsPartitionedWorld())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("NPCCoverBakeCommandlet: %s is partitioned, only its always loaded actors are baked"), *MapPackage);
+	}
+
+	// Navigation is rebuilt so the bake never reads a navmesh older than the geometry
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World))
+	{
+		NavSys->Build();
+	}
+
+	ANPCCoverData* CoverData = nullptr;
+	for (TActorIterator<ANPCCoverData> It(World); It; ++It)
+	{
+		CoverData = *It;
+		break;
+	}
+	if (!CoverData)
+	{
+		CoverData = World->SpawnActor<ANPCCoverData>();
+	}
+
+	bool bSucceeded = CoverData != nullptr;
+	if (CoverData)
+	{
+#if WITH_EDITOR
+		CoverData->BakeCover();
+#endif
+		UE_LOG(LogTemp, Display, TEXT("NPCCoverBakeCommandlet: %s: %d cover points"), *MapPackage, CoverData->NumPoints());
+
+		if (bSave)
+		{
+			bSucceeded = SavePackage(Package, World, FPackageName::GetMapPackageExtension());
+
+			// Maps with one file per actor keep the cover data in its own package
+			if (UPackage* ActorPackage = CoverData->GetExternalPackage())
+			{
+				bSucceeded &= SavePackage(ActorPackage, nullptr, FPackageName::GetAssetPackageExtension());
+			}
+		}
+	}
+
+	World->CleanupWorld();
+	World->RemoveFromRoot();
+	return bSucceeded;
+}
+
+bool UNPCCoverBakeCommandlet::SavePackage(UPackage* Package, UObject* Asset, const FString& Extension) const
+{
+	const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), Extension);
+
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Standalone;
+	if (!UPackage::SavePackage(Package, Asset, *Filename, SaveArgs))
+	{
+		UE_LOG(LogTemp, Error, TEXT("NPCCoverBakeCommandlet: Failed to save %s"), *Filename);
+		return false;
+	}
+	return true;
+}
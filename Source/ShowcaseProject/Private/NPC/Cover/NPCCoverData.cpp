@@ -0,0 +1,183 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NPC/Cover/NPCCoverData.h"
+
+#include "Algo/LowerBound.h"
+#include "NPC/Cover/NPCCoverSubsystem.h"
+
+#if WITH_EDITOR
+#include "Engine/World.h"
+#include "NavigationSystem.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "World/SpatialHashGrid.h"
+#endif
+
+namespace
+{
+	FORCEINLINE bool CellLess(const FIntPoint& A, const FIntPoint& B)
+	{
+		return A.X < B.X || (A.X == B.X && A.Y < B.Y);
+	}
+}
+
+ANPCCoverData::ANPCCoverData()
+{
+	PrimaryActorTick.bCanEverTick = false;
+}
+
+void ANPCCoverData::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UNPCCoverSubsystem* Cover = GetWorld()->GetSubsystem<UNPCCoverSubsystem>())
+	{
+		RegistryId = Cover->RegisterCoverData(this);
+	}
+}
+
+void ANPCCoverData::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UNPCCoverSubsystem* Cover = GetWorld()->GetSubsystem<UNPCCoverSubsystem>())
+	{
+		Cover->UnregisterCoverData(RegistryId);
+	}
+	RegistryId = INDEX_NONE;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+FIntPoint ANPCCoverData::GetCell(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+int32 ANPCCoverData::FindFirstCell(const FIntPoint& Cell) const
+{
+	return Algo::LowerBoundBy(Cells, Cell, &FNPCCoverCell::Cell, &CellLess);
+}
+
+#if WITH_EDITOR
+void ANPCCoverData::BakeCover()
+{
+	UWorld* World = GetWorld();
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	const ARecastNavMesh* NavMesh = NavSys ? Cast<ARecastNavMesh>(NavSys->GetDefaultNavDataInstance()) : nullptr;
+	if (!NavMesh)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("NPCCoverData: %s has no recast navmesh to bake from"), *GetNameSafe(World));
+		return;
+	}
+
+	Modify();
+	Points.Reset();
+
+	// Only static geometry, anything that moves is left to the runtime visibility check
+	const FCollisionObjectQueryParams ObjectParams(ECC_WorldStatic);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(NPCCoverBake), true);
+	const float CosMergeAngle = FMath::Cos(FMath::DegreesToRadians(45.0f));
+
+	TSpatialHashGrid<int32> PointGrid(MinPointSpacing);
+	TArray<FVector> Verts;
+	TArray<FNavigationPortalEdge> Portals;
+	TArray<FNavPoly> Polys;
+
+	for (int32 TileIndex = 0; TileIndex < NavMesh->GetNavMeshTilesCount(); ++TileIndex)
+	{
+		Polys.Reset();
+		if (!NavMesh->GetPolysInTile(TileIndex, Polys)) continue;
+
+		for (const FNavPoly& Poly : Polys)
+		{
+			Verts.Reset();
+			Portals.Reset();
+			if (!NavMesh->GetPolyVerts(Poly.Ref, Verts)) continue;
+			NavMesh->GetPolyEdges(Poly.Ref, Portals);
+
+			for (int32 VertIndex = 0; VertIndex < Verts.Num(); ++VertIndex)
+			{
+				const FVector EdgeStart = Verts[VertIndex];
+				const FVector EdgeEnd = Verts[(VertIndex + 1) % Verts.Num()];
+				const FVector EdgeMid = (EdgeStart + EdgeEnd) * 0.5f;
+
+				// Edges shared with another polygon are walkable on both sides
+				const bool bIsPortal = Portals.ContainsByPredicate([&EdgeMid](const FNavigationPortalEdge& Portal)
+				{
+					return FMath::PointDistToSegmentSquared(EdgeMid, Portal.Left, Portal.Right) < 1.0f;
+				});
+				if (bIsPortal) continue;
+
+				const FVector EdgeDirection = (EdgeEnd - EdgeStart).GetSafeNormal2D();
+				FVector Outward(EdgeDirection.Y, -EdgeDirection.X, 0.0f);
+				if (FVector::DotProduct(Outward, EdgeMid - Poly.Center) < 0.0f)
+				{
+					Outward = -Outward;
+				}
+
+				const float EdgeLength = FVector::Dist2D(EdgeStart, EdgeEnd);
+				for (float Distance = SampleSpacing * 0.5f; Distance < EdgeLength; Distance += SampleSpacing)
+				{
+					const FVector Sample = FMath::Lerp(EdgeStart, EdgeEnd, Distance / EdgeLength);
+
+					// Nothing at crouch height means a drop or open space, not cover
+					FHitResult LowHit;
+					const FVector LowStart = Sample + FVector(0.0f, 0.0f, LowProbeHeight);
+					if (!World->LineTraceSingleByObjectType(LowHit, LowStart, LowStart + Outward * ProbeDistance, ObjectParams, QueryParams)
+						|| FMath::Abs(LowHit.ImpactNormal.Z) > 0.5f)
+					{
+						continue;
+					}
+
+					const FVector Facing = -LowHit.ImpactNormal.GetSafeNormal2D();
+					const FVector HighStart = Sample + FVector(0.0f, 0.0f, HighProbeHeight);
+					const bool bIsHigh = World->LineTraceTestByObjectType(HighStart, HighStart + Facing * ProbeDistance, ObjectParams, QueryParams);
+
+					bool bMerged = false;
+					PointGrid.ForEachInRadius(Sample, MinPointSpacing, [&](int32 OtherIndex)
+					{
+						const FNPCCoverPoint& Other = Points[OtherIndex];
+						bMerged |= FVector::DistSquared(Other.GetLocation(), Sample) < FMath::Square(MinPointSpacing)
+							&& FVector::DotProduct(Other.GetFacing(), Facing) > CosMergeAngle;
+					});
+					if (bMerged) continue;
+
+					FNPCCoverPoint& Point = Points.AddDefaulted_GetRef();
+					Point.Location = FVector3f(Sample);
+					Point.SetFacing(Facing);
+					Point.Height = bIsHigh ? ENPCCoverHeight::High : ENPCCoverHeight::Low;
+					PointGrid.Add(Points.Num() - 1, Sample);
+				}
+			}
+		}
+	}
+
+	BuildCells();
+
+	UE_LOG(LogTemp, Display, TEXT("NPCCoverData: Baked %d cover points in %d cells for %s"), Points.Num(), Cells.Num(), *GetNameSafe(World));
+}
+
+void ANPCCoverData::BuildCells()
+{
+	Points.Sort([](const FNPCCoverPoint& A, const FNPCCoverPoint& B)
+	{
+		return CellLess(GetCell(A.GetLocation()), GetCell(B.GetLocation()));
+	});
+
+	Cells.Reset();
+	for (int32 PointIndex = 0; PointIndex < Points.Num(); ++PointIndex)
+	{
+		const FIntPoint Cell = GetCell(Points[PointIndex].GetLocation());
+		if (Cells.Num() == 0 || Cells.Last().Cell != Cell)
+		{
+			FNPCCoverCell& NewCell = Cells.AddDefaulted_GetRef();
+			NewCell.Cell = Cell;
+			NewCell.FirstPoint = PointIndex;
+		}
+		++Cells.Last().NumPoints;
+	}
+
+	Points.Shrink();
+	Cells.Shrink();
+	NumBakedPoints = Points.Num();
+}
+#endif
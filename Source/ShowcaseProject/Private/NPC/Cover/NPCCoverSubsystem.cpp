@@ -0,0 +1,148 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NPC/Cover/NPCCoverSubsystem.h"
+
+#include "Engine/World.h"
+#include "Interfaces/DamageableInterface.h"
+
+void UNPCCoverSubsystem::Deinitialize()
+{
+	CoverDataById.Empty();
+	Occupants.Empty();
+	CoverByUser.Empty();
+
+	Super::Deinitialize();
+}
+
+int32 UNPCCoverSubsystem::RegisterCoverData(const ANPCCoverData* CoverData)
+{
+	if (!CoverData) return INDEX_NONE;
+
+	UE_LOG(LogTemp, Verbose, TEXT("NPCCoverSubsystem: Registered %d cover points from %s"), CoverData->NumPoints(), *CoverData->GetName());
+	return CoverDataById.Add(CoverData);
+}
+
+void UNPCCoverSubsystem::UnregisterCoverData(int32 DataId)
+{
+	if (!CoverDataById.IsValidIndex(DataId)) return;
+
+	CoverDataById.RemoveAt(DataId);
+
+	// The id gets reused, occupants of the old points must not carry over
+	for (auto It = Occupants.CreateIterator(); It; ++It)
+	{
+		if (static_cast<int32>(It.Key() >> 32) == DataId)
+		{
+			if (const AActor* User = It.Value().Get())
+			{
+				CoverByUser.Remove(User);
+			}
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool UNPCCoverSubsystem::FindBestCover(const AActor* Querier, const FVector& ThreatLocation, const AActor* Threat, float Radius, FNPCCoverResult& OutCover) const
+{
+	if (!Querier || Radius <= 0.0f) return false;
+
+	const FVector QuerierLocation = Querier->GetActorLocation();
+	const float CosMaxThreatAngle = FMath::Cos(FMath::DegreesToRadians(MaxThreatAngleDegrees));
+
+	FNPCCoverResult Best;
+	float BestScore = -UE_BIG_NUMBER;
+
+	for (auto DataIt = CoverDataById.CreateConstIterator(); DataIt; ++DataIt)
+	{
+		const ANPCCoverData* CoverData = DataIt->Get();
+		if (!CoverData) continue;
+
+		const int32 DataId = DataIt.GetIndex();
+		CoverData->ForEachPointInRadius(QuerierLocation, Radius, [&](int32 PointIndex, const FNPCCoverPoint& Point)
+		{
+			const FVector Location = Point.GetLocation();
+			const float DistanceSquared = FVector::DistSquared(Location, QuerierLocation);
+			if (DistanceSquared > FMath::Square(Radius)) return;
+
+			if (FVector::DistSquared2D(ThreatLocation, Location) < FMath::Square(MinThreatDistance)) return;
+
+			const FVector ToThreat = (ThreatLocation - Location).GetSafeNormal2D();
+			const float FacingDot = FVector::DotProduct(Point.GetFacing(), ToThreat);
+			if (FacingDot < CosMaxThreatAngle) return;
+
+			const float Score = FacingDot - FMath::Sqrt(DistanceSquared) / Radius
+				+ (Point.Height == ENPCCoverHeight::High ? HighCoverBonus : 0.0f);
+			if (Score <= BestScore || IsOccupied(MakeCoverKey(DataId, PointIndex), Querier)) return;
+
+			Best.Location = Location;
+			Best.Facing = Point.GetFacing();
+			Best.Height = Point.Height;
+			Best.DataId = DataId;
+			Best.PointIndex = PointIndex;
+			BestScore = Score;
+		});
+	}
+
+	// The bake only saw static geometry, one trace confirms nothing else opened a line to the threat.
+	// An exposed winner fails the query, the caller asks again once things have moved
+	if (!Best.IsSet() || IsExposed(Best, ThreatLocation, Querier, Threat)) return false;
+
+	OutCover = Best;
+	return true;
+}
+
+void UNPCCoverSubsystem::ClaimCover(const FNPCCoverResult& Cover, AActor* User)
+{
+	if (!User || !Cover.IsSet()) return;
+
+	ReleaseCover(User);
+
+	const uint64 CoverKey = MakeCoverKey(Cover.DataId, Cover.PointIndex);
+
+	// A dead or destroyed occupant never released the point, its entry goes with it. Matched on the key
+	// since a destroyed occupant can no longer be looked up by pointer
+	if (Occupants.Contains(CoverKey))
+	{
+		for (auto It = CoverByUser.CreateIterator(); It; ++It)
+		{
+			if (It.Value() == CoverKey)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	Occupants.Add(CoverKey, User);
+	CoverByUser.Add(User, CoverKey);
+}
+
+void UNPCCoverSubsystem::ReleaseCover(const AActor* User)
+{
+	uint64 CoverKey;
+	if (User && CoverByUser.RemoveAndCopyValue(User, CoverKey))
+	{
+		Occupants.Remove(CoverKey);
+	}
+}
+
+bool UNPCCoverSubsystem::IsOccupied(uint64 CoverKey, const AActor* Querier) const
+{
+	const TWeakObjectPtr<AActor>* Occupant = Occupants.Find(CoverKey);
+	const AActor* User = Occupant ? Occupant->Get() : nullptr;
+	if (!User || User == Querier) return false;
+
+	// Dead users that never released their point do not block it
+	const IDamageableInterface* Damageable = Cast<IDamageableInterface>(User);
+	return !Damageable || Damageable->IsAlive();
+}
+
+bool UNPCCoverSubsystem::IsExposed(const FNPCCoverResult& Cover, const FVector& ThreatLocation, const AActor* Querier, const AActor* Threat) const
+{
+	const float TraceHeight = Cover.Height == ENPCCoverHeight::High ? HighCoverTraceHeight : LowCoverTraceHeight;
+	const FVector CoverLocation = Cover.Location + FVector(0.0f, 0.0f, TraceHeight);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(NPCCoverVisibility), false, Querier);
+	QueryParams.AddIgnoredActor(Threat);
+	return !GetWorld()->LineTraceTestByChannel(ThreatLocation, CoverLocation, ECC_Visibility, QueryParams);
+}
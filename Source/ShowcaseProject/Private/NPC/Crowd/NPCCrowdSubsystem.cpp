@@ -0,0 +1,305 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NPC/Crowd/NPCCrowdSubsystem.h"
+
+#include "AIController.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StreamableManager.h"
+#include "GameFramework/PlayerController.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "NPC/Spawning/NPCSpawnerSubsystem.h"
+
+namespace
+{
+	// Custom data floats per proxy instance, read by the vertex animation material
+	constexpr int32 CrowdStateDataIndex = 0;
+	constexpr int32 CrowdPhaseDataIndex = 1;
+	constexpr int32 NumCrowdCustomData = 2;
+}
+
+void UNPCCrowdSubsystem::Deinitialize()
+{
+	if (IsValid(CrowdHost))
+	{
+		CrowdHost->Destroy();
+	}
+	CrowdHost = nullptr;
+	InstancesByMesh.Empty();
+	Agents.Empty();
+	PendingDemotions.Empty();
+
+	Super::Deinitialize();
+}
+
+void UNPCCrowdSubsystem::RequestDemotion(ANPC_BaseCharacter* NPC)
+{
+	if (NPC && !NPC->GetNPCData().CrowdProxyMesh.IsNull())
+	{
+		PendingDemotions.AddUnique(NPC);
+	}
+}
+
+void UNPCCrowdSubsystem::Tick(float DeltaTime)
+{
+	FVector ViewLocation;
+	if (!GetViewLocation(ViewLocation)) return;
+
+	ProcessDemotions(ViewLocation);
+	ProcessRehydrations(ViewLocation);
+
+	TimeSinceSimulation += DeltaTime;
+	if (TimeSinceSimulation >= SimulationInterval)
+	{
+		SimulateAgents(TimeSinceSimulation);
+		TimeSinceSimulation = 0.0f;
+	}
+}
+
+bool UNPCCrowdSubsystem::IsTickable() const
+{
+	return Agents.Num() > 0 || PendingDemotions.Num() > 0;
+}
+
+TStatId UNPCCrowdSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNPCCrowdSubsystem, STATGROUP_Tickables);
+}
+
+bool UNPCCrowdSubsystem::GetViewLocation(FVector& OutLocation) const
+{
+	const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	if (!PC) return false;
+
+	FRotator ViewRotation;
+	PC->GetPlayerViewPoint(OutLocation, ViewRotation);
+	return true;
+}
+
+void UNPCCrowdSubsystem::ProcessDemotions(const FVector& ViewLocation)
+{
+	int32 NumDemoted = 0;
+	for (int32 Index = 0; Index < PendingDemotions.Num() && NumDemoted < MaxDemotionsPerFrame; )
+	{
+		ANPC_BaseCharacter* NPC = PendingDemotions[Index].Get();
+		if (!NPC || NPC->GetSignificance() != ENPCSignificance::Dormant)
+		{
+			PendingDemotions.RemoveAtSwap(Index, EAllowShrinking::No);
+			continue;
+		}
+
+		// Busy or still too close, a dormant NPC stays queued until it can go
+		if (!CanDemote(*NPC, ViewLocation))
+		{
+			++Index;
+			continue;
+		}
+
+		// Stays queued until its proxy mesh is streamed in
+		const TSoftObjectPtr<UStaticMesh>& ProxyMesh = NPC->GetNPCData().CrowdProxyMesh;
+		if (UStaticMesh* LoadedMesh = ProxyMesh.Get())
+		{
+			PendingDemotions.RemoveAtSwap(Index, EAllowShrinking::No);
+			DemoteNPC(*NPC, *LoadedMesh);
+			++NumDemoted;
+			continue;
+		}
+
+		UAssetManager::GetStreamableManager().RequestAsyncLoad(ProxyMesh.ToSoftObjectPath());
+		++Index;
+	}
+}
+
+bool UNPCCrowdSubsystem::CanDemote(const ANPC_BaseCharacter& NPC, const FVector& ViewLocation) const
+{
+	const ENPCState State = NPC.GetCurrentState();
+	if (!NPC.IsAlive() || NPC.bIsInDialogue || State == ENPCState::Combat || State == ENPCState::Alert
+		|| State == ENPCState::Flee || State == ENPCState::TakeCover)
+	{
+		return false;
+	}
+
+	return FVector::DistSquared(ViewLocation, NPC.GetActorLocation()) > FMath::Square(DemoteDistance);
+}
+
+void UNPCCrowdSubsystem::DemoteNPC(ANPC_BaseCharacter& NPC, UStaticMesh& ProxyMesh)
+{
+	FNPCCrowdAgent& Agent = Agents.AddDefaulted_GetRef();
+	Agent.NPCClass = NPC.GetClass();
+	Agent.NPCDataHandle = NPC.NPCDataHandle;
+	Agent.Transform = NPC.GetActorTransform();
+	Agent.State = NPC.GetCurrentState();
+	Agent.Health = NPC.CurrentHealth;
+
+	if (const AAIController* AIController = Cast<AAIController>(NPC.GetController()))
+	{
+		if (AIController->GetMoveStatus() == EPathFollowingStatus::Moving)
+		{
+			Agent.MoveTarget = AIController->GetImmediateMoveDestination();
+			Agent.bHasMoveTarget = true;
+		}
+	}
+
+	Agent.Instances = GetOrCreateInstances(&ProxyMesh);
+	if (Agent.Instances)
+	{
+		Agent.InstanceIndex = Agent.Instances->AddInstance(Agent.Transform, true);
+		Agent.Instances->SetCustomDataValue(Agent.InstanceIndex, CrowdStateDataIndex, static_cast<float>(Agent.State), false);
+		Agent.Instances->SetCustomDataValue(Agent.InstanceIndex, CrowdPhaseDataIndex, FMath::FRand(), true);
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("NPCCrowdSubsystem: Demoted %s, %d crowd agents"), *NPC.GetName(), Agents.Num());
+
+	// Pooled so rehydrating this type later skips building a new actor
+	if (UNPCSpawnerSubsystem* Spawner = GetWorld()->GetSubsystem<UNPCSpawnerSubsystem>())
+	{
+		Spawner->ReleaseNPC(&NPC);
+	}
+	else
+	{
+		// Destroying the pawn also destroys its AI controller
+		NPC.Destroy();
+	}
+}
+
+void UNPCCrowdSubsystem::ProcessRehydrations(const FVector& ViewLocation)
+{
+	int32 NumRehydrated = 0;
+	for (int32 AgentIndex = Agents.Num() - 1; AgentIndex >= 0 && NumRehydrated < MaxRehydrationsPerFrame; --AgentIndex)
+	{
+		if (FVector::DistSquared(ViewLocation, Agents[AgentIndex].Transform.GetLocation()) > FMath::Square(RehydrateDistance))
+		{
+			continue;
+		}
+
+		// The spawner had nothing to hand out, the agent stays a proxy and is tried again next frame
+		if (!RehydrateAgent(Agents[AgentIndex]))
+		{
+			break;
+		}
+
+		RemoveAgent(AgentIndex);
+		++NumRehydrated;
+	}
+}
+
+bool UNPCCrowdSubsystem::RehydrateAgent(const FNPCCrowdAgent& Agent)
+{
+	UClass* NPCClass = Agent.NPCClass.Get();
+	if (!NPCClass) return false;
+
+	// Rehydration is already budgeted per frame, so it takes the NPC now rather than queueing
+	UNPCSpawnerSubsystem* Spawner = GetWorld()->GetSubsystem<UNPCSpawnerSubsystem>();
+	ANPC_BaseCharacter* NPC = Spawner ? Spawner->AcquireNPC(NPCClass, Agent.NPCDataHandle, Agent.Transform) : nullptr;
+	if (!NPC) return false;
+
+	// Spawning starts from the table defaults, put back what the proxy carried
+	NPC->CurrentHealth = FMath::Min(Agent.Health, NPC->MaxHealth);
+	NPC->SetNPCState(Agent.State);
+
+	if (Agent.bHasMoveTarget)
+	{
+		if (AAIController* AIController = Cast<AAIController>(NPC->GetController()))
+		{
+			AIController->MoveToLocation(Agent.MoveTarget);
+		}
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("NPCCrowdSubsystem: Rehydrated %s"), *NPC->GetName());
+	return true;
+}
+
+void UNPCCrowdSubsystem::RemoveAgent(int32 AgentIndex)
+{
+	const FNPCCrowdAgent& Agent = Agents[AgentIndex];
+	UInstancedStaticMeshComponent* Instances = Agent.Instances;
+	const int32 InstanceIndex = Agent.InstanceIndex;
+
+	Agents.RemoveAtSwap(AgentIndex, EAllowShrinking::No);
+
+	if (IsValid(Instances) && Instances->RemoveInstance(InstanceIndex))
+	{
+		// Instances after the removed one shift down by one
+		for (FNPCCrowdAgent& Other : Agents)
+		{
+			if (Other.Instances == Instances && Other.InstanceIndex > InstanceIndex)
+			{
+				--Other.InstanceIndex;
+			}
+		}
+	}
+}
+
+void UNPCCrowdSubsystem::SimulateAgents(float DeltaTime)
+{
+	const float MaxStep = AgentWalkSpeed * DeltaTime;
+
+	TSet<UInstancedStaticMeshComponent*> DirtyInstances;
+	for (FNPCCrowdAgent& Agent : Agents)
+	{
+		if (!Agent.bHasMoveTarget) continue;
+
+		const FVector Location = Agent.Transform.GetLocation();
+		FVector ToTarget = Agent.MoveTarget - Location;
+		ToTarget.Z = 0.0f;
+
+		const float Distance = ToTarget.Size();
+		if (Distance <= MaxStep)
+		{
+			Agent.Transform.SetLocation(FVector(Agent.MoveTarget.X, Agent.MoveTarget.Y, Location.Z));
+			Agent.bHasMoveTarget = false;
+		}
+		else
+		{
+			const FVector Direction = ToTarget / Distance;
+			Agent.Transform.SetLocation(Location + Direction * MaxStep);
+			Agent.Transform.SetRotation(Direction.ToOrientationQuat());
+		}
+
+		if (IsValid(Agent.Instances))
+		{
+			Agent.Instances->UpdateInstanceTransform(Agent.InstanceIndex, Agent.Transform, true, false, true);
+			DirtyInstances.Add(Agent.Instances);
+		}
+	}
+
+	// One render state update per mesh for the whole pass
+	for (UInstancedStaticMeshComponent* Instances : DirtyInstances)
+	{
+		Instances->MarkRenderStateDirty();
+	}
+}
+
+UInstancedStaticMeshComponent* UNPCCrowdSubsystem::GetOrCreateInstances(UStaticMesh* ProxyMesh)
+{
+	if (UInstancedStaticMeshComponent* const* Existing = InstancesByMesh.Find(ProxyMesh))
+	{
+		return *Existing;
+	}
+
+	if (!IsValid(CrowdHost))
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.Name = TEXT("NPCCrowdHost");
+		SpawnParams.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+		CrowdHost = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		if (!CrowdHost) return nullptr;
+
+		USceneComponent* Root = NewObject<USceneComponent>(CrowdHost, TEXT("Root"));
+		CrowdHost->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+
+	UInstancedStaticMeshComponent* Instances = NewObject<UInstancedStaticMeshComponent>(CrowdHost);
+	Instances->SetStaticMesh(ProxyMesh);
+	Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Instances->SetCanEverAffectNavigation(false);
+	Instances->NumCustomDataFloats = NumCrowdCustomData;
+	Instances->SetupAttachment(CrowdHost->GetRootComponent());
+	Instances->RegisterComponent();
+
+	InstancesByMesh.Add(ProxyMesh, Instances);
+	return Instances;
+}
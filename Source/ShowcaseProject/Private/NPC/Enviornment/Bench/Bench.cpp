@@ -24,6 +24,7 @@ void ABench::BeginPlay()
 	if (InteractionSlots.Num() == 0)
 	{
 		GenerateBenchSlots();
+		RefreshRegistration();
 	}
 }
 
@@ -3,6 +3,9 @@
 
 #include "NPC/PatrolPath/PatrolPath.h"
 
+#include "Algo/Reverse.h"
+#include "NavigationSystem.h"
+
 APatrolPath::APatrolPath()
 {
 	PrimaryActorTick.bCanEverTick = false;
@@ -17,3 +20,128 @@ int APatrolPath::Num() const
 {
 	return PatrolPoints.Num();
 }
+
+FVector APatrolPath::GetPatrolPointLocation(int32 Index) const
+{
+	return GetActorTransform().TransformPosition(GetPatrolPoint(Index));
+}
+
+void APatrolPath::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ResetSegments();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void APatrolPath::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	// Points or the actor moved, every leg is stale
+	ResetSegments();
+}
+
+FNavPathSharedPtr APatrolPath::GetLegPath(int32 FromIndex, int32 ToIndex)
+{
+	const int32 NumPoints = PatrolPoints.Num();
+	if (NumPoints < 2 || !PatrolPoints.IsValidIndex(FromIndex) || !PatrolPoints.IsValidIndex(ToIndex)) return nullptr;
+
+	// Backward legs walk the forward segment in reverse
+	const bool bForward = ToIndex == (FromIndex + 1) % NumPoints;
+	const bool bBackward = FromIndex == (ToIndex + 1) % NumPoints;
+	if (!bForward && !bBackward) return nullptr;
+
+	const FPatrolPathSegment* Segment = GetOrBuildSegment(bForward ? FromIndex : ToIndex);
+	if (!Segment) return nullptr;
+
+	// Followers get their own path object, the path following component keeps per-move state on it
+	TArray<FVector> Points;
+	Points.Reserve(Segment->Path->GetPathPoints().Num());
+	for (const FNavPathPoint& PathPoint : Segment->Path->GetPathPoints())
+	{
+		Points.Add(PathPoint.Location);
+	}
+	if (!bForward)
+	{
+		Algo::Reverse(Points);
+	}
+
+	FNavPathSharedPtr LegPath = MakeShared<FNavigationPath, ESPMode::ThreadSafe>(Points);
+	LegPath->SetNavigationDataUsed(Segment->Path->GetNavigationDataUsed());
+	return LegPath;
+}
+
+const FPatrolPathSegment* APatrolPath::GetOrBuildSegment(int32 SegmentIndex)
+{
+	if (Segments.Num() != PatrolPoints.Num())
+	{
+		ResetSegments();
+		Segments.SetNum(PatrolPoints.Num());
+	}
+
+	FPatrolPathSegment& Segment = Segments[SegmentIndex];
+	if (Segment.Path.IsValid())
+	{
+		return &Segment;
+	}
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance() : nullptr;
+	if (!NavData) return nullptr;
+
+	const FVector Start = GetPatrolPointLocation(SegmentIndex);
+	const FVector End = GetPatrolPointLocation((SegmentIndex + 1) % PatrolPoints.Num());
+	const FPathFindingResult Result = NavSys->FindPathSync(FPathFindingQuery(this, *NavData, Start, End));
+	if (!Result.IsSuccessful() || !Result.Path.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: No navmesh path from patrol point %d to the next"), *GetName(), SegmentIndex);
+		return nullptr;
+	}
+
+	Segment.Path = Result.Path;
+	Segment.bIsPartial = Result.IsPartial();
+
+	// Found again lazily when it is next needed rather than re-pathed in the background
+	Segment.Path->EnableRecalculationOnInvalidation(false);
+	Segment.ObserverHandle = Segment.Path->AddObserver(
+		FNavigationPath::FPathObserverDelegate::FDelegate::CreateUObject(this, &APatrolPath::HandleSegmentPathEvent));
+
+	if (Segment.bIsPartial)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Patrol point %d or the next one is off the navmesh, leg is partial"), *GetName(), SegmentIndex);
+	}
+	return &Segment;
+}
+
+void APatrolPath::ResetSegment(FPatrolPathSegment& Segment)
+{
+	if (Segment.Path.IsValid())
+	{
+		Segment.Path->RemoveObserver(Segment.ObserverHandle);
+	}
+	Segment = FPatrolPathSegment();
+}
+
+void APatrolPath::ResetSegments()
+{
+	for (FPatrolPathSegment& Segment : Segments)
+	{
+		ResetSegment(Segment);
+	}
+	Segments.Reset();
+}
+
+void APatrolPath::HandleSegmentPathEvent(FNavigationPath* Path, ENavPathEvent::Type Event)
+{
+	if (Event != ENavPathEvent::Invalidated) return;
+
+	for (int32 SegmentIndex = 0; SegmentIndex < Segments.Num(); ++SegmentIndex)
+	{
+		if (Segments[SegmentIndex].Path.Get() == Path)
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("%s: Navmesh changed under patrol leg %d"), *GetName(), SegmentIndex);
+			ResetSegment(Segments[SegmentIndex]);
+			return;
+		}
+	}
+}
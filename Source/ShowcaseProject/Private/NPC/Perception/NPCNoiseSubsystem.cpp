@@ -0,0 +1,102 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NPC/Perception/NPCNoiseSubsystem.h"
+
+#include "NPC/Controller/NPC_AIController.h"
+#include "NPC/Perception/NPCPerceptionSubsystem.h"
+
+void UNPCNoiseSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UNPCNoiseSubsystem::HandlePostActorTick);
+}
+
+void UNPCNoiseSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	Events.Empty();
+
+	Super::Deinitialize();
+}
+
+void UNPCNoiseSubsystem::ReportNoise(const FVector& Location, float Loudness, AActor* Instigator, FName Tag)
+{
+	if (Loudness <= 0.0f) return;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (FNPCNoiseEvent& Event : Events)
+	{
+		if (Event.Tag != Tag || Now - Event.Time > MergeWindow || FVector::DistSquared(Event.Location, Location) > FMath::Square(MergeRadius))
+		{
+			continue;
+		}
+
+		++Event.NumMerged;
+		if (Loudness > Event.Loudness)
+		{
+			// Already heard at the old loudness, only worth another dispatch if it carries noticeably further
+			if (Event.bDispatched && Loudness >= Event.Loudness * RedispatchLoudnessRatio)
+			{
+				Event.bDispatched = false;
+			}
+			Event.Loudness = Loudness;
+			Event.Location = Location;
+		}
+		return;
+	}
+
+	FNPCNoiseEvent& Event = Events.AddDefaulted_GetRef();
+	Event.Location = Location;
+	Event.Loudness = Loudness;
+	Event.Instigator = Instigator;
+	Event.Tag = Tag;
+	Event.Time = Now;
+}
+
+void UNPCNoiseSubsystem::HandlePostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld() || Events.Num() == 0) return;
+
+	int32 NumDispatched = 0;
+	int32 NumReported = 0;
+	for (FNPCNoiseEvent& Event : Events)
+	{
+		if (!Event.bDispatched)
+		{
+			DispatchEvent(Event);
+			Event.bDispatched = true;
+			NumReported += Event.NumMerged;
+			++NumDispatched;
+		}
+	}
+
+	if (NumDispatched > 0)
+	{
+		UE_LOG(LogTemp, VeryVerbose, TEXT("NPCNoiseSubsystem: Dispatched %d noise events covering %d reports"), NumDispatched, NumReported);
+	}
+
+	// Kept until their merge window closes so follow-up shots fold into them
+	const double Now = World->GetTimeSeconds();
+	Events.RemoveAllSwap([Now](const FNPCNoiseEvent& Event) { return Now - Event.Time > MergeWindow; });
+}
+
+void UNPCNoiseSubsystem::DispatchEvent(const FNPCNoiseEvent& Event) const
+{
+	const UNPCPerceptionSubsystem* Perception = GetWorld()->GetSubsystem<UNPCPerceptionSubsystem>();
+	if (!Perception) return;
+
+	AActor* Instigator = Event.Instigator.Get();
+	Perception->ForEachListenerInRadius(Event.Location, Perception->GetMaxHearingRange() * Event.Loudness,
+		[&Event, Instigator](ANPC_AIController* Controller, float HearingRange)
+		{
+			const APawn* Pawn = Controller->GetPawn();
+			if (!Pawn || Pawn == Instigator) return;
+
+			if (FVector::DistSquared(Pawn->GetActorLocation(), Event.Location) <= FMath::Square(HearingRange * Event.Loudness))
+			{
+				Controller->HandleNoiseHeard(Event.Location, Instigator, Event.Tag);
+			}
+		});
+}
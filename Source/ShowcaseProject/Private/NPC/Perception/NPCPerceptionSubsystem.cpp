@@ -0,0 +1,303 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NPC/Perception/NPCPerceptionSubsystem.h"
+
+#include "Algo/StableSort.h"
+#include "NPC/Character/NPC_BaseCharacter.h"
+#include "NPC/Controller/NPC_AIController.h"
+
+void UNPCPerceptionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TraceDelegate.BindUObject(this, &UNPCPerceptionSubsystem::HandleTraceDone);
+}
+
+void UNPCPerceptionSubsystem::Deinitialize()
+{
+	TraceDelegate.Unbind();
+	Listeners.Empty();
+	ListenerGrid.Reset();
+	SightTargets.Empty();
+	PendingChecks.Empty();
+	InFlightChecks.Empty();
+
+	Super::Deinitialize();
+}
+
+int32 UNPCPerceptionSubsystem::RegisterListener(ANPC_AIController* Controller, float SightRadius, float LoseSightRadius, float PeripheralVisionAngleDegrees, float HearingRange)
+{
+	if (!Controller) return INDEX_NONE;
+
+	FSharedSightListener Listener;
+	Listener.Controller = Controller;
+	Listener.SightRadius = SightRadius;
+	Listener.LoseSightRadius = FMath::Max(SightRadius, LoseSightRadius);
+	Listener.CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(PeripheralVisionAngleDegrees));
+	Listener.HearingRange = HearingRange;
+
+	MaxLoseSightRadius = FMath::Max(MaxLoseSightRadius, Listener.LoseSightRadius);
+	MaxHearingRange = FMath::Max(MaxHearingRange, HearingRange);
+	return Listeners.Add(MoveTemp(Listener));
+}
+
+void UNPCPerceptionSubsystem::UnregisterListener(int32 ListenerId)
+{
+	if (!Listeners.IsValidIndex(ListenerId)) return;
+
+	ListenerGrid.Remove(ListenerId);
+	Listeners.RemoveAt(ListenerId);
+}
+
+void UNPCPerceptionSubsystem::ForgetSeenTargets(int32 ListenerId)
+{
+	if (!Listeners.IsValidIndex(ListenerId)) return;
+
+	// Copied, publishing removes from the listener's list
+	const TArray<TWeakObjectPtr<AActor>, TInlineAllocator<2>> SeenTargets = Listeners[ListenerId].SeenTargets;
+	for (const TWeakObjectPtr<AActor>& Target : SeenTargets)
+	{
+		if (AActor* SeenTarget = Target.Get())
+		{
+			PublishSight(ListenerId, SeenTarget, false);
+		}
+	}
+	Listeners[ListenerId].SeenTargets.Reset();
+}
+
+void UNPCPerceptionSubsystem::RegisterSightTarget(AActor* Target)
+{
+	if (Target)
+	{
+		SightTargets.AddUnique(Target);
+	}
+}
+
+void UNPCPerceptionSubsystem::UnregisterSightTarget(AActor* Target)
+{
+	SightTargets.RemoveSingleSwap(Target);
+}
+
+void UNPCPerceptionSubsystem::Tick(float DeltaTime)
+{
+	UpdateListenerGrid();
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	SightTargets.RemoveAllSwap([](const TWeakObjectPtr<AActor>& Target) { return !Target.IsValid(); });
+	for (const TWeakObjectPtr<AActor>& Target : SightTargets)
+	{
+		ScheduleChecks(*Target.Get(), Now);
+	}
+
+	ExpireSeenTargets();
+	IssueTraces();
+}
+
+bool UNPCPerceptionSubsystem::IsTickable() const
+{
+	// The grid is kept current for noise dispatch even without sight targets
+	return Listeners.Num() > 0;
+}
+
+TStatId UNPCPerceptionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNPCPerceptionSubsystem, STATGROUP_Tickables);
+}
+
+void UNPCPerceptionSubsystem::UpdateListenerGrid()
+{
+	for (auto It = Listeners.CreateIterator(); It; ++It)
+	{
+		const ANPC_AIController* Controller = It->Controller.Get();
+		const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+		if (Pawn)
+		{
+			ListenerGrid.Update(It.GetIndex(), Pawn->GetActorLocation());
+		}
+		else
+		{
+			ListenerGrid.Remove(It.GetIndex());
+		}
+	}
+}
+
+void UNPCPerceptionSubsystem::ScheduleChecks(AActor& Target, double Now)
+{
+	const FVector TargetLocation = Target.GetActorLocation();
+	const uint64 Frame = GFrameCounter;
+
+	ListenerGrid.ForEachInRadius(TargetLocation, MaxLoseSightRadius, [&](int32 ListenerId)
+	{
+		FSharedSightListener& Listener = Listeners[ListenerId];
+		const ANPC_AIController* Controller = Listener.Controller.Get();
+		const ANPC_BaseCharacter* NPC = Controller ? Cast<ANPC_BaseCharacter>(Controller->GetPawn()) : nullptr;
+		if (!NPC || NPC == &Target) return;
+
+		// A listener that cannot look any more loses what it saw rather than keeping it forever
+		const ENPCSignificance Significance = NPC->GetSignificance();
+		const FNPCSignificanceSettings& Settings = FNPCSignificanceSettings::Get(Significance);
+		if (!NPC->IsAlive() || !Settings.bEnableSight)
+		{
+			if (Listener.SeenTargets.Contains(&Target))
+			{
+				PublishSight(ListenerId, &Target, false);
+			}
+			return;
+		}
+
+		const bool bScheduledThisFrame = Listener.ScheduledFrame == Frame;
+		if (!bScheduledThisFrame && (Listener.NumPendingChecks > 0 || Now < Listener.NextCheckTime)) return;
+
+		if (!bScheduledThisFrame)
+		{
+			Listener.ScheduledFrame = Frame;
+			Listener.NextCheckTime = Now + Settings.SightCheckInterval;
+		}
+
+		// Range and cone are free, only what passes them costs a trace
+		const bool bWasSeen = Listener.SeenTargets.Contains(&Target);
+		const FVector ToTarget = TargetLocation - NPC->GetActorLocation();
+		const float Radius = bWasSeen ? Listener.LoseSightRadius : Listener.SightRadius;
+		const float DistanceSquared = ToTarget.SizeSquared();
+
+		const bool bInRange = DistanceSquared <= FMath::Square(Radius);
+		const bool bInCone = DistanceSquared > UE_KINDA_SMALL_NUMBER
+			&& FVector::DotProduct(NPC->GetActorForwardVector(), ToTarget * FMath::InvSqrt(DistanceSquared)) >= Listener.CosHalfAngle;
+
+		if (!bInRange || !bInCone)
+		{
+			if (bWasSeen)
+			{
+				PublishSight(ListenerId, &Target, false);
+			}
+			return;
+		}
+
+		FSharedSightCheck& Check = PendingChecks.AddDefaulted_GetRef();
+		Check.ListenerId = ListenerId;
+		Check.Controller = Listener.Controller;
+		Check.Target = &Target;
+		Check.Significance = Significance;
+		++Listener.NumPendingChecks;
+	});
+}
+
+void UNPCPerceptionSubsystem::ExpireSeenTargets()
+{
+	// The grid pass only reaches listeners near a target, one that outran a slow listener is dropped here
+	for (auto It = Listeners.CreateIterator(); It; ++It)
+	{
+		FSharedSightListener& Listener = *It;
+		if (Listener.SeenTargets.Num() == 0) continue;
+
+		const ANPC_AIController* Controller = Listener.Controller.Get();
+		const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+		if (!Pawn)
+		{
+			ForgetSeenTargets(It.GetIndex());
+			continue;
+		}
+
+		const FVector ListenerLocation = Pawn->GetActorLocation();
+		for (int32 Index = Listener.SeenTargets.Num() - 1; Index >= 0; --Index)
+		{
+			AActor* Target = Listener.SeenTargets[Index].Get();
+			if (!Target)
+			{
+				Listener.SeenTargets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			}
+			else if (!SightTargets.Contains(Target)
+				|| FVector::DistSquared(ListenerLocation, Target->GetActorLocation()) > FMath::Square(Listener.LoseSightRadius))
+			{
+				PublishSight(It.GetIndex(), Target, false);
+			}
+		}
+	}
+}
+
+void UNPCPerceptionSubsystem::IssueTraces()
+{
+	if (PendingChecks.Num() == 0) return;
+
+	// Over budget, the most significant listeners go first and the rest wait their turn in order
+	if (PendingChecks.Num() > MaxTracesPerFrame)
+	{
+		Algo::StableSortBy(PendingChecks, &FSharedSightCheck::Significance);
+	}
+
+	const int32 NumToIssue = FMath::Min(PendingChecks.Num(), MaxTracesPerFrame);
+	for (int32 Index = 0; Index < NumToIssue; ++Index)
+	{
+		const FSharedSightCheck& Check = PendingChecks[Index];
+		const bool bListenerAlive = Listeners.IsValidIndex(Check.ListenerId) && Listeners[Check.ListenerId].Controller == Check.Controller;
+
+		const ANPC_AIController* Controller = Check.Controller.Get();
+		const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+		const AActor* Target = Check.Target.Get();
+		if (!bListenerAlive || !Pawn || !Target)
+		{
+			if (bListenerAlive)
+			{
+				--Listeners[Check.ListenerId].NumPendingChecks;
+			}
+			continue;
+		}
+
+		FVector EyesLocation;
+		FRotator EyesRotation;
+		Pawn->GetActorEyesViewPoint(EyesLocation, EyesRotation);
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(NPCSharedSight), false, Pawn);
+
+		const uint32 TraceId = ++NextTraceId;
+		InFlightChecks.Add(TraceId, Check);
+		GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, EyesLocation, Target->GetActorLocation(), ECC_Visibility,
+			QueryParams, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, TraceId);
+	}
+
+	PendingChecks.RemoveAt(0, NumToIssue, EAllowShrinking::No);
+}
+
+void UNPCPerceptionSubsystem::HandleTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	FSharedSightCheck Check;
+	if (!InFlightChecks.RemoveAndCopyValue(TraceDatum.UserData, Check)) return;
+
+	// The listener may have been unregistered and its id reused while the trace was running
+	if (!Listeners.IsValidIndex(Check.ListenerId) || Listeners[Check.ListenerId].Controller != Check.Controller) return;
+
+	--Listeners[Check.ListenerId].NumPendingChecks;
+
+	AActor* Target = Check.Target.Get();
+	if (!Target) return;
+
+	const FHitResult* BlockingHit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+	const ANPC_AIController* Controller = Check.Controller.Get();
+	const ANPC_BaseCharacter* NPC = Controller ? Cast<ANPC_BaseCharacter>(Controller->GetPawn()) : nullptr;
+
+	// Died while the trace was running, a late hit must not hand it back what ScheduleChecks took away
+	const bool bSeen = NPC && NPC->IsAlive() && (!BlockingHit || BlockingHit->GetActor() == Target);
+	PublishSight(Check.ListenerId, Target, bSeen);
+}
+
+void UNPCPerceptionSubsystem::PublishSight(int32 ListenerId, AActor* Target, bool bSeen)
+{
+	FSharedSightListener& Listener = Listeners[ListenerId];
+	const bool bWasSeen = Listener.SeenTargets.Contains(Target);
+	if (bSeen == bWasSeen) return;
+
+	if (bSeen)
+	{
+		Listener.SeenTargets.Add(Target);
+	}
+	else
+	{
+		Listener.SeenTargets.RemoveSingleSwap(Target);
+	}
+
+	if (ANPC_AIController* Controller = Listener.Controller.Get())
+	{
+		Controller->HandleSightUpdated(Target, bSeen);
+	}
+}
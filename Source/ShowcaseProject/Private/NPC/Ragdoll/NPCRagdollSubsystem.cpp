@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NPC/Ragdoll/NPCRagdollSubsystem.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "NPC/Character/NPC_BaseCharacter.h"
+
+void UNPCRagdollSubsystem::Deinitialize()
+{
+	Simulating.Empty();
+	Frozen.Empty();
+
+	Super::Deinitialize();
+}
+
+void UNPCRagdollSubsystem::RequestRagdoll(ANPC_BaseCharacter* NPC, const FVector& ImpulseLocation, const FVector& ImpulseDirection)
+{
+	if (!NPC) return;
+
+	Simulating.RemoveAll([](const FNPCRagdollEntry& Entry) { return !Entry.NPC.IsValid(); });
+	while (Simulating.Num() >= MaxSimulatingRagdolls)
+	{
+		FreezeOldestSimulating();
+	}
+
+	NPC->EnableRagdoll(ImpulseLocation, ImpulseDirection);
+
+	FNPCRagdollEntry& Entry = Simulating.AddDefaulted_GetRef();
+	Entry.NPC = NPC;
+	Entry.StartTime = GetWorld()->GetTimeSeconds();
+}
+
+void UNPCRagdollSubsystem::ReleaseRagdoll(ANPC_BaseCharacter* NPC)
+{
+	Simulating.RemoveAll([NPC](const FNPCRagdollEntry& Entry) { return Entry.NPC == NPC; });
+	Frozen.Remove(NPC);
+}
+
+void UNPCRagdollSubsystem::Tick(float DeltaTime)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	for (int32 Index = 0; Index < Simulating.Num();)
+	{
+		FNPCRagdollEntry& Entry = Simulating[Index];
+		ANPC_BaseCharacter* NPC = Entry.NPC.Get();
+		const USkeletalMeshComponent* Mesh = NPC ? NPC->GetMesh() : nullptr;
+		if (!Mesh)
+		{
+			Simulating.RemoveAt(Index);
+			continue;
+		}
+
+		const bool bResting = !Mesh->RigidBodyIsAwake() || Mesh->GetPhysicsLinearVelocity().SizeSquared() < FMath::Square(SettleSpeed);
+		Entry.SettledTime = bResting ? Entry.SettledTime + DeltaTime : 0.0f;
+
+		if (Entry.SettledTime >= SettleTime || Now - Entry.StartTime >= MaxSimulateTime)
+		{
+			Simulating.RemoveAt(Index);
+			Freeze(*NPC);
+			continue;
+		}
+
+		++Index;
+	}
+}
+
+bool UNPCRagdollSubsystem::IsTickable() const
+{
+	return Simulating.Num() > 0;
+}
+
+TStatId UNPCRagdollSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNPCRagdollSubsystem, STATGROUP_Tickables);
+}
+
+void UNPCRagdollSubsystem::FreezeOldestSimulating()
+{
+	const FNPCRagdollEntry Oldest = Simulating[0];
+	Simulating.RemoveAt(0);
+
+	if (ANPC_BaseCharacter* NPC = Oldest.NPC.Get())
+	{
+		Freeze(*NPC);
+	}
+}
+
+void UNPCRagdollSubsystem::Freeze(ANPC_BaseCharacter& NPC)
+{
+	NPC.FreezeRagdollPose();
+
+	Frozen.RemoveAll([](const TWeakObjectPtr<ANPC_BaseCharacter>& Corpse) { return !Corpse.IsValid(); });
+	Frozen.Add(&NPC);
+
+	// Too many corpses lying around, the oldest goes now instead of at its death cleanup
+	if (Frozen.Num() > MaxFrozenCorpses)
+	{
+		// Recycled while still listed, the pool puts the mesh back together before anything reuses it
+		ANPC_BaseCharacter* Oldest = Frozen[0].Get();
+		Oldest->RecycleCorpse();
+		Frozen.Remove(Oldest);
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("NPCRagdollSubsystem: Froze %s, %d simulating, %d frozen"), *NPC.GetName(), Simulating.Num(), Frozen.Num());
+}
@@ -0,0 +1,158 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NPC/Significance/NPCSignificanceSubsystem.h"
+
+#include "GameFramework/PlayerController.h"
+#include "NPC/Character/NPC_BaseCharacter.h"
+
+namespace
+{
+	FNPCSignificanceSettings MakeSignificanceSettings(float ActorInterval, float AnimationInterval, float StateTreeInterval, float ControllerInterval,
+		float SightInterval, bool bEnableSight, bool bEnableURO, EVisibilityBasedAnimTickOption AnimTickOption)
+	{
+		FNPCSignificanceSettings Settings;
+		Settings.ActorTickInterval = ActorInterval;
+		Settings.AnimationTickInterval = AnimationInterval;
+		Settings.StateTreeTickInterval = StateTreeInterval;
+		Settings.ControllerTickInterval = ControllerInterval;
+		Settings.SightCheckInterval = SightInterval;
+		Settings.bEnableSight = bEnableSight;
+		Settings.bEnableUpdateRateOptimizations = bEnableURO;
+		Settings.VisibilityBasedAnimTickOption = AnimTickOption;
+		return Settings;
+	}
+
+	bool IsCombatState(ENPCState State)
+	{
+		return State == ENPCState::Alert || State == ENPCState::Combat || State == ENPCState::Flee || State == ENPCState::TakeCover;
+	}
+}
+
+const FNPCSignificanceSettings& FNPCSignificanceSettings::Get(ENPCSignificance Significance)
+{
+	static const FNPCSignificanceSettings Settings[] =
+	{
+		// Critical: everything at full rate, no URO so close-up animation never skips
+		MakeSignificanceSettings(0.0f, 0.0f, 0.0f, 0.0f, 0.1f, true, false, EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones),
+		// High
+		MakeSignificanceSettings(0.0f, 0.0f, 0.0f, 0.0f, 0.2f, true, true, EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones),
+		// Medium
+		MakeSignificanceSettings(0.1f, 1.0f / 30.0f, 0.1f, 0.1f, 0.4f, true, true, EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered),
+		// Low
+		MakeSignificanceSettings(0.25f, 0.1f, 0.25f, 0.25f, 1.0f, true, true, EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered),
+		// Dormant: no sight, only montages keep advancing off screen
+		MakeSignificanceSettings(1.0f, 0.5f, 0.5f, 1.0f, 0.0f, false, true, EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered),
+	};
+	return Settings[FMath::Min(static_cast<int32>(Significance), static_cast<int32>(UE_ARRAY_COUNT(Settings)) - 1)];
+}
+
+void UNPCSignificanceSubsystem::RegisterNPC(ANPC_BaseCharacter* NPC)
+{
+	if (!NPC) return;
+
+	for (const FNPCSignificanceEntry& Entry : Entries)
+	{
+		if (Entry.NPC == NPC) return;
+	}
+
+	FNPCSignificanceEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.NPC = NPC;
+	Entry.Significance = NPC->GetSignificance();
+}
+
+void UNPCSignificanceSubsystem::UnregisterNPC(ANPC_BaseCharacter* NPC)
+{
+	Entries.RemoveAllSwap([NPC](const FNPCSignificanceEntry& Entry) { return Entry.NPC == NPC; });
+}
+
+int32 UNPCSignificanceSubsystem::GetNumNPCsWithSignificance(ENPCSignificance Significance) const
+{
+	int32 Count = 0;
+	for (const FNPCSignificanceEntry& Entry : Entries)
+	{
+		if (Entry.Significance == Significance && Entry.NPC.IsValid())
+		{
+			++Count;
+		}
+	}
+	return Count;
+}
+
+void UNPCSignificanceSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceUpdate += DeltaTime;
+	if (TimeSinceUpdate < UpdateInterval) return;
+	TimeSinceUpdate = 0.0f;
+
+	const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	if (!PC) return;
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	Entries.RemoveAllSwap([](const FNPCSignificanceEntry& Entry) { return !Entry.NPC.IsValid(); });
+
+	int32 NumChanged = 0;
+	for (FNPCSignificanceEntry& Entry : Entries)
+	{
+		ANPC_BaseCharacter* NPC = Entry.NPC.Get();
+		const ENPCSignificance NewSignificance = ScoreNPC(*NPC, Entry.Significance, ViewLocation);
+		if (NewSignificance != Entry.Significance)
+		{
+			Entry.Significance = NewSignificance;
+			NPC->ApplySignificance(NewSignificance);
+			++NumChanged;
+		}
+	}
+
+	UE_LOG(LogTemp, VeryVerbose, TEXT("NPCSignificanceSubsystem: Scored %d NPCs, %d changed bucket"), Entries.Num(), NumChanged);
+}
+
+bool UNPCSignificanceSubsystem::IsTickable() const
+{
+	return Entries.Num() > 0;
+}
+
+TStatId UNPCSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNPCSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+ENPCSignificance UNPCSignificanceSubsystem::ScoreNPC(const ANPC_BaseCharacter& NPC, ENPCSignificance CurrentSignificance, const FVector& ViewLocation) const
+{
+	if (!NPC.IsAlive()) return ENPCSignificance::Dormant;
+
+	// The player is talking to it
+	if (NPC.bIsInDialogue) return ENPCSignificance::Critical;
+
+	static constexpr float BandEdges[] = { CriticalDistance, HighDistance, MediumDistance, LowDistance };
+
+	const float DistanceSquared = FVector::DistSquared(ViewLocation, NPC.GetActorLocation());
+	int32 Band = static_cast<int32>(ENPCSignificance::Dormant);
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(BandEdges); ++Index)
+	{
+		// Bands the NPC is already in or above reach a little further
+		const float Edge = BandEdges[Index] + (static_cast<int32>(CurrentSignificance) <= Index ? DemotionHysteresis : 0.0f);
+		if (DistanceSquared < FMath::Square(Edge))
+		{
+			Band = Index;
+			break;
+		}
+	}
+
+	// Nothing to look at, one band down
+	if (!NPC.WasRecentlyRendered(VisibilityGracePeriod))
+	{
+		Band = FMath::Min(Band + 1, static_cast<int32>(ENPCSignificance::Dormant));
+	}
+
+	// Fighting NPCs keep reacting at a usable rate wherever they are
+	if (IsCombatState(NPC.GetCurrentState()))
+	{
+		Band = FMath::Min(Band, static_cast<int32>(ENPCSignificance::Medium));
+	}
+
+	return static_cast<ENPCSignificance>(Band);
+}
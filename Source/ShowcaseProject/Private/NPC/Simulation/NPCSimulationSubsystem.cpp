@@ -0,0 +1,285 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NPC/Simulation/NPCSimulationSubsystem.h"
+
+#include "Async/ParallelFor.h"
+#include "NPC/Character/NPC_BaseCharacter.h"
+
+namespace
+{
+	// Per second at an average Alertness trait, watchful NPCs calm down slower
+	constexpr float BaseAlertnessDecayRate = 0.1f;
+}
+
+void UNPCSimulationSubsystem::Deinitialize()
+{
+	for (const TWeakObjectPtr<ANPC_BaseCharacter>& NPC : NPCs)
+	{
+		if (NPC.IsValid())
+		{
+			NPC->SetSimulationIndex(INDEX_NONE);
+		}
+	}
+
+	NPCs.Empty();
+	Alertness.Empty();
+	AlertnessDecayRates.Empty();
+	RegenDelays.Empty();
+	RegenHealths.Empty();
+	RegenMaxHealths.Empty();
+	RegenRates.Empty();
+	TimesInState.Empty();
+	CleanupDelays.Empty();
+	Flags.Empty();
+	Events.Empty();
+
+	Super::Deinitialize();
+}
+
+void UNPCSimulationSubsystem::RegisterNPC(ANPC_BaseCharacter* NPC)
+{
+	if (!NPC || FindIndex(NPC) != INDEX_NONE) return;
+
+	const int32 Index = NPCs.Add(NPC);
+	Alertness.Add(0.0f);
+	AlertnessDecayRates.Add(BaseAlertnessDecayRate * FMath::Lerp(1.5f, 0.5f, NPC->GetNPCData().Alertness));
+	RegenDelays.Add(0.0f);
+	RegenHealths.Add(0.0f);
+	RegenMaxHealths.Add(0.0f);
+	RegenRates.Add(0.0f);
+	TimesInState.Add(0.0f);
+	CleanupDelays.Add(0.0f);
+	Flags.Add(NPC->IsAlive() ? Flag_Alive : 0);
+	Events.Add(0);
+
+	NPC->SetSimulationIndex(Index);
+}
+
+void UNPCSimulationSubsystem::UnregisterNPC(ANPC_BaseCharacter* NPC)
+{
+	const int32 Index = FindIndex(NPC);
+	if (Index != INDEX_NONE)
+	{
+		RemoveAtSwap(Index);
+		NPC->SetSimulationIndex(INDEX_NONE);
+	}
+}
+
+void UNPCSimulationSubsystem::RaiseAlertness(const ANPC_BaseCharacter* NPC, float Amount)
+{
+	const int32 Index = FindIndex(NPC);
+	if (Index != INDEX_NONE)
+	{
+		Alertness[Index] = FMath::Clamp(Alertness[Index] + Amount, 0.0f, 1.0f);
+	}
+}
+
+float UNPCSimulationSubsystem::GetAlertness(const ANPC_BaseCharacter* NPC) const
+{
+	const int32 Index = FindIndex(NPC);
+	return Index != INDEX_NONE ? Alertness[Index] : 0.0f;
+}
+
+void UNPCSimulationSubsystem::NotifyStateChanged(const ANPC_BaseCharacter* NPC)
+{
+	const int32 Index = FindIndex(NPC);
+	if (Index != INDEX_NONE)
+	{
+		TimesInState[Index] = 0.0f;
+		Flags[Index] = NPC->IsAlive() ? (Flags[Index] | Flag_Alive) : (Flags[Index] & ~(Flag_Alive | Flag_Regenerating));
+	}
+}
+
+float UNPCSimulationSubsystem::GetTimeInState(const ANPC_BaseCharacter* NPC) const
+{
+	const int32 Index = FindIndex(NPC);
+	return Index != INDEX_NONE ? TimesInState[Index] : 0.0f;
+}
+
+void UNPCSimulationSubsystem::NotifyDamaged(const ANPC_BaseCharacter* NPC)
+{
+	const int32 Index = FindIndex(NPC);
+	if (Index != INDEX_NONE && NPC->HealthRegenPerSecond > 0.0f && NPC->CurrentHealth < NPC->MaxHealth)
+	{
+		RegenDelays[Index] = NPC->HealthRegenDelay;
+		RegenHealths[Index] = NPC->CurrentHealth;
+		RegenMaxHealths[Index] = NPC->MaxHealth;
+		RegenRates[Index] = NPC->HealthRegenPerSecond;
+		Flags[Index] |= Flag_Regenerating;
+	}
+}
+
+void UNPCSimulationSubsystem::ScheduleCleanup(const ANPC_BaseCharacter* NPC, float Delay)
+{
+	const int32 Index = FindIndex(NPC);
+	if (Index != INDEX_NONE)
+	{
+		CleanupDelays[Index] = Delay;
+		Flags[Index] |= Flag_CleanupPending;
+	}
+}
+
+void UNPCSimulationSubsystem::CancelCleanup(const ANPC_BaseCharacter* NPC)
+{
+	const int32 Index = FindIndex(NPC);
+	if (Index != INDEX_NONE)
+	{
+		Flags[Index] &= ~Flag_CleanupPending;
+	}
+}
+
+void UNPCSimulationSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceStep = FMath::Min(TimeSinceStep + DeltaTime, SimulationStep * MaxStepsPerFrame);
+	while (TimeSinceStep >= SimulationStep)
+	{
+		TimeSinceStep -= SimulationStep;
+		Step();
+		DispatchEvents();
+	}
+}
+
+bool UNPCSimulationSubsystem::IsTickable() const
+{
+	return NPCs.Num() > 0;
+}
+
+TStatId UNPCSimulationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNPCSimulationSubsystem, STATGROUP_Tickables);
+}
+
+int32 UNPCSimulationSubsystem::FindIndex(const ANPC_BaseCharacter* NPC) const
+{
+	if (!NPC) return INDEX_NONE;
+
+	const int32 Index = NPC->GetSimulationIndex();
+	return NPCs.IsValidIndex(Index) && NPCs[Index] == NPC ? Index : INDEX_NONE;
+}
+
+void UNPCSimulationSubsystem::RemoveAtSwap(int32 Index)
+{
+	NPCs.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Alertness.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	AlertnessDecayRates.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RegenDelays.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RegenHealths.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RegenMaxHealths.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RegenRates.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	TimesInState.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	CleanupDelays.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Flags.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Events.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	// The last entry moved into the gap
+	if (NPCs.IsValidIndex(Index) && NPCs[Index].IsValid())
+	{
+		NPCs[Index]->SetSimulationIndex(Index);
+	}
+}
+
+void UNPCSimulationSubsystem::Step()
+{
+	// Entries only write their own index, so the pass splits across workers without locks
+	ParallelFor(NPCs.Num(), [this](int32 Index) { StepEntry(Index); },
+		NPCs.Num() < ParallelForMinNPCs ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+void UNPCSimulationSubsystem::StepEntry(int32 Index)
+{
+	uint8 EntryEvents = 0;
+	uint8 EntryFlags = Flags[Index];
+
+	TimesInState[Index] += SimulationStep;
+
+	if (EntryFlags & Flag_Alive)
+	{
+		const float OldAlertness = Alertness[Index];
+		if (OldAlertness > 0.0f)
+		{
+			const float NewAlertness = FMath::Max(0.0f, OldAlertness - AlertnessDecayRates[Index] * SimulationStep);
+			Alertness[Index] = NewAlertness;
+			if (OldAlertness >= CalmAlertness && NewAlertness < CalmAlertness)
+			{
+				EntryEvents |= Event_Calmed;
+			}
+		}
+
+		if (EntryFlags & Flag_Regenerating)
+		{
+			RegenDelays[Index] -= SimulationStep;
+			if (RegenDelays[Index] <= 0.0f)
+			{
+				const float MaxHealth = RegenMaxHealths[Index];
+				const float OldHealth = RegenHealths[Index];
+				const float NewHealth = FMath::Min(MaxHealth, OldHealth + RegenRates[Index] * SimulationStep);
+				RegenHealths[Index] = NewHealth;
+
+				// Back at full health stops until the next hit, on the way there only whole shares are handed over
+				const float PublishStep = MaxHealth * RegenPublishFraction;
+				if (NewHealth >= MaxHealth)
+				{
+					EntryEvents |= Event_Regenerate;
+					EntryFlags &= ~Flag_Regenerating;
+				}
+				else if (PublishStep > 0.0f && FMath::FloorToInt(NewHealth / PublishStep) > FMath::FloorToInt(OldHealth / PublishStep))
+				{
+					EntryEvents |= Event_Regenerate;
+				}
+			}
+		}
+	}
+
+	if (EntryFlags & Flag_CleanupPending)
+	{
+		CleanupDelays[Index] -= SimulationStep;
+		if (CleanupDelays[Index] <= 0.0f)
+		{
+			EntryEvents |= Event_CleanupDue;
+			EntryFlags &= ~Flag_CleanupPending;
+		}
+	}
+
+	Flags[Index] = EntryFlags;
+	Events[Index] = EntryEvents;
+}
+
+void UNPCSimulationSubsystem::DispatchEvents()
+{
+	// Handlers can unregister NPCs and reorder the arrays, so collect first
+	TArray<TPair<TWeakObjectPtr<ANPC_BaseCharacter>, uint8>, TInlineAllocator<16>> Pending;
+	for (int32 Index = 0; Index < Events.Num(); ++Index)
+	{
+		if (Events[Index] != 0)
+		{
+			Pending.Emplace(NPCs[Index], Events[Index]);
+			Events[Index] = 0;
+		}
+	}
+
+	for (const TPair<TWeakObjectPtr<ANPC_BaseCharacter>, uint8>& Entry : Pending)
+	{
+		ANPC_BaseCharacter* NPC = Entry.Key.Get();
+		if (!NPC) continue;
+
+		if (Entry.Value & Event_Calmed)
+		{
+			NPC->OnAlertnessCalmed();
+		}
+
+		if (Entry.Value & Event_Regenerate)
+		{
+			const int32 Index = FindIndex(NPC);
+			if (Index != INDEX_NONE)
+			{
+				NPC->ApplyRegeneratedHealth(RegenHealths[Index]);
+			}
+		}
+
+		if (Entry.Value & Event_CleanupDue)
+		{
+			NPC->RecycleCorpse();
+		}
+	}
+}
@@ -0,0 +1,338 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NPC/SmartObject/ShowcaseSmartObjectSubsystem.h"
+
+#include "Interfaces/DamageableInterface.h"
+
+void UShowcaseSmartObjectSubsystem::Deinitialize()
+{
+	{
+		FWriteScopeLock WriteLock(RegistryLock);
+		Entries.Empty();
+		for (TSpatialHashGrid<int32>& Grid : GridsByType)
+		{
+			Grid.Reset();
+		}
+	}
+
+	{
+		FScopeLock ClaimsLock(&ClaimsByUserLock);
+		ClaimsByUser.Empty();
+		NumClaimUsers.store(0, std::memory_order_relaxed);
+	}
+
+	Super::Deinitialize();
+}
+
+int32 UShowcaseSmartObjectSubsystem::RegisterSmartObject(ASmartObject* SmartObject)
+{
+	check(IsInGameThread());
+	if (!SmartObject) return INDEX_NONE;
+
+	const int32 NumSlots = SmartObject->InteractionSlots.Num();
+	if (NumSlots > MaxSlots)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ShowcaseSmartObjectSubsystem: %s has %d slots, only the first %d are used"), *SmartObject->GetName(), NumSlots, MaxSlots);
+	}
+
+	FWriteScopeLock WriteLock(RegistryLock);
+
+	const int32 RegistryId = Entries.Emplace();
+	FSmartObjectEntry& Entry = Entries[RegistryId];
+	Entry.Object = SmartObject;
+	Entry.Type = SmartObject->ObjectType;
+	Entry.Location = SmartObject->GetActorLocation();
+
+	uint64 FreeSlots = 0;
+	Entry.ClaimSerials.SetNumZeroed(FMath::Min(NumSlots, MaxSlots));
+	for (int32 SlotIndex = 0; SlotIndex < Entry.ClaimSerials.Num(); ++SlotIndex)
+	{
+		Entry.SlotLocations.Add(SmartObject->GetSlotWorldLocation(SlotIndex));
+
+		// Every slot starts free, bIsOccupied is only the object's mirror of claims made through here
+		FreeSlots |= (1ull << SlotIndex);
+	}
+	Entry.FreeSlots.store(FreeSlots);
+
+	GetGrid(Entry.Type).Add(RegistryId, Entry.Location);
+	return RegistryId;
+}
+
+void UShowcaseSmartObjectSubsystem::UnregisterSmartObject(int32 RegistryId)
+{
+	check(IsInGameThread());
+
+	{
+		FWriteScopeLock WriteLock(RegistryLock);
+		if (!Entries.IsValidIndex(RegistryId)) return;
+
+		GetGrid(Entries[RegistryId].Type).Remove(RegistryId);
+		Entries.RemoveAt(RegistryId);
+	}
+
+	// The id gets reused, claims on the old object must not be released against the new one
+	FScopeLock ClaimsLock(&ClaimsByUserLock);
+	for (auto It = ClaimsByUser.CreateIterator(); It; ++It)
+	{
+		It.Value().RemoveAllSwap([RegistryId](const FSmartObjectClaimHandle& Claim) { return Claim.RegistryId == RegistryId; });
+		if (It.Value().Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+	NumClaimUsers.store(ClaimsByUser.Num(), std::memory_order_relaxed);
+}
+
+uint64 UShowcaseSmartObjectSubsystem::GetFreeSlots(int32 RegistryId) const
+{
+	FReadScopeLock ReadLock(RegistryLock);
+	return Entries.IsValidIndex(RegistryId) ? Entries[RegistryId].FreeSlots.load(std::memory_order_acquire) : 0;
+}
+
+FSmartObjectSlotRef UShowcaseSmartObjectSubsystem::FindNearestFreeSlot(ESmartObjectType Type, const FVector& Location, float Radius) const
+{
+	FReadScopeLock ReadLock(RegistryLock);
+	return FindNearestFreeSlotLocked(Type, Location, Radius);
+}
+
+FSmartObjectClaimHandle UShowcaseSmartObjectSubsystem::ClaimSlot(const FSmartObjectSlotRef& Slot, const AActor* User)
+{
+	FSmartObjectClaimHandle Claim;
+	{
+		FReadScopeLock ReadLock(RegistryLock);
+		Claim = ClaimSlotLocked(Slot, User);
+	}
+
+	if (Claim.IsSet())
+	{
+		TrackClaim(Claim);
+	}
+	return Claim;
+}
+
+FSmartObjectClaimHandle UShowcaseSmartObjectSubsystem::ClaimNearestFreeSlot(ESmartObjectType Type, const FVector& Location, float Radius, const AActor* User)
+{
+	FSmartObjectClaimHandle Claim;
+	{
+		FReadScopeLock ReadLock(RegistryLock);
+		for (int32 Attempt = 0; Attempt < MaxClaimAttempts && !Claim.IsSet(); ++Attempt)
+		{
+			const FSmartObjectSlotRef Slot = FindNearestFreeSlotLocked(Type, Location, Radius);
+			if (!Slot.IsSet()) break;
+
+			Claim = ClaimSlotLocked(Slot, User);
+		}
+	}
+
+	if (Claim.IsSet())
+	{
+		TrackClaim(Claim);
+	}
+	return Claim;
+}
+
+bool UShowcaseSmartObjectSubsystem::ReleaseClaim(const FSmartObjectClaimHandle& Claim)
+{
+	bool bReleased;
+	{
+		FReadScopeLock ReadLock(RegistryLock);
+		bReleased = ReleaseClaimLocked(Claim);
+	}
+
+	UntrackClaim(Claim);
+	return bReleased;
+}
+
+bool UShowcaseSmartObjectSubsystem::IsClaimValid(const FSmartObjectClaimHandle& Claim) const
+{
+	if (!Claim.IsSet()) return false;
+
+	FReadScopeLock ReadLock(RegistryLock);
+	if (!Entries.IsValidIndex(Claim.RegistryId)) return false;
+
+	const FSmartObjectEntry& Entry = Entries[Claim.RegistryId];
+	return Entry.ClaimSerials.IsValidIndex(Claim.SlotIndex) && Entry.ClaimSerials[Claim.SlotIndex].load(std::memory_order_acquire) == Claim.Serial;
+}
+
+void UShowcaseSmartObjectSubsystem::ReleaseClaimsForUser(const AActor* User)
+{
+	check(IsInGameThread());
+	if (!User) return;
+
+	TArray<FSmartObjectClaimHandle, TInlineAllocator<1>> Claims;
+	{
+		FScopeLock ClaimsLock(&ClaimsByUserLock);
+		ClaimsByUser.RemoveAndCopyValue(FObjectKey(User), Claims);
+		NumClaimUsers.store(ClaimsByUser.Num(), std::memory_order_relaxed);
+	}
+
+	ReleaseAndNotify(Claims);
+}
+
+ASmartObject* UShowcaseSmartObjectSubsystem::GetSmartObject(int32 RegistryId) const
+{
+	check(IsInGameThread());
+
+	FReadScopeLock ReadLock(RegistryLock);
+	return Entries.IsValidIndex(RegistryId) ? Entries[RegistryId].Object.Get() : nullptr;
+}
+
+int32 UShowcaseSmartObjectSubsystem::GetNumSmartObjects(ESmartObjectType Type) const
+{
+	FReadScopeLock ReadLock(RegistryLock);
+	return GetGrid(Type).Num();
+}
+
+void UShowcaseSmartObjectSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceSweep += DeltaTime;
+	if (TimeSinceSweep < StaleClaimSweepInterval) return;
+	TimeSinceSweep = 0.0f;
+
+	SweepStaleClaims();
+}
+
+bool UShowcaseSmartObjectSubsystem::IsTickable() const
+{
+	// A stale count at worst delays the sweep by a frame
+	return NumClaimUsers.load(std::memory_order_relaxed) > 0;
+}
+
+TStatId UShowcaseSmartObjectSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShowcaseSmartObjectSubsystem, STATGROUP_Tickables);
+}
+
+FSmartObjectSlotRef UShowcaseSmartObjectSubsystem::FindNearestFreeSlotLocked(ESmartObjectType Type, const FVector& Location, float Radius) const
+{
+	FSmartObjectSlotRef Result;
+
+	float BestDistanceSquared = FMath::Square(Radius);
+	GetGrid(Type).ForEachInRadius(Location, Radius, [&](int32 RegistryId)
+	{
+		const FSmartObjectEntry& Entry = Entries[RegistryId];
+		for (uint64 Remaining = Entry.FreeSlots.load(std::memory_order_relaxed); Remaining; Remaining &= Remaining - 1)
+		{
+			const int32 SlotIndex = static_cast<int32>(FMath::CountTrailingZeros64(Remaining));
+			const float DistanceSquared = FVector::DistSquared(Location, Entry.SlotLocations[SlotIndex]);
+			if (DistanceSquared <= BestDistanceSquared)
+			{
+				BestDistanceSquared = DistanceSquared;
+				Result.RegistryId = RegistryId;
+				Result.SlotIndex = SlotIndex;
+			}
+		}
+	});
+
+	return Result;
+}
+
+FSmartObjectClaimHandle UShowcaseSmartObjectSubsystem::ClaimSlotLocked(const FSmartObjectSlotRef& Slot, const AActor* User)
+{
+	FSmartObjectClaimHandle Claim;
+	if (!User || !Entries.IsValidIndex(Slot.RegistryId)) return Claim;
+
+	FSmartObjectEntry& Entry = Entries[Slot.RegistryId];
+	if (!Entry.ClaimSerials.IsValidIndex(Slot.SlotIndex)) return Claim;
+
+	// Whoever clears the bit owns the slot
+	const uint64 SlotBit = 1ull << Slot.SlotIndex;
+	if ((Entry.FreeSlots.fetch_and(~SlotBit, std::memory_order_acq_rel) & SlotBit) == 0) return Claim;
+
+	uint32 Serial = LastClaimSerial.fetch_add(1, std::memory_order_relaxed) + 1;
+	if (Serial == 0)
+	{
+		// Wrapped, 0 means free
+		Serial = LastClaimSerial.fetch_add(1, std::memory_order_relaxed) + 1;
+	}
+	Entry.ClaimSerials[Slot.SlotIndex].store(Serial, std::memory_order_release);
+
+	Claim.RegistryId = Slot.RegistryId;
+	Claim.SlotIndex = Slot.SlotIndex;
+	Claim.Serial = Serial;
+	Claim.User = FObjectKey(User);
+	return Claim;
+}
+
+bool UShowcaseSmartObjectSubsystem::ReleaseClaimLocked(const FSmartObjectClaimHandle& Claim)
+{
+	if (!Claim.IsSet() || !Entries.IsValidIndex(Claim.RegistryId)) return false;
+
+	FSmartObjectEntry& Entry = Entries[Claim.RegistryId];
+	if (!Entry.ClaimSerials.IsValidIndex(Claim.SlotIndex)) return false;
+
+	// Only the holder of the current serial frees the slot, a second release of the same handle does nothing
+	uint32 ExpectedSerial = Claim.Serial;
+	if (!Entry.ClaimSerials[Claim.SlotIndex].compare_exchange_strong(ExpectedSerial, 0, std::memory_order_acq_rel)) return false;
+
+	Entry.FreeSlots.fetch_or(1ull << Claim.SlotIndex, std::memory_order_release);
+	return true;
+}
+
+void UShowcaseSmartObjectSubsystem::TrackClaim(const FSmartObjectClaimHandle& Claim)
+{
+	FScopeLock ClaimsLock(&ClaimsByUserLock);
+	ClaimsByUser.FindOrAdd(Claim.User).Add(Claim);
+	NumClaimUsers.store(ClaimsByUser.Num(), std::memory_order_relaxed);
+}
+
+void UShowcaseSmartObjectSubsystem::UntrackClaim(const FSmartObjectClaimHandle& Claim)
+{
+	FScopeLock ClaimsLock(&ClaimsByUserLock);
+	if (TArray<FSmartObjectClaimHandle, TInlineAllocator<1>>* Claims = ClaimsByUser.Find(Claim.User))
+	{
+		Claims->RemoveSingleSwap(Claim);
+		if (Claims->Num() == 0)
+		{
+			ClaimsByUser.Remove(Claim.User);
+			NumClaimUsers.store(ClaimsByUser.Num(), std::memory_order_relaxed);
+		}
+	}
+}
+
+void UShowcaseSmartObjectSubsystem::SweepStaleClaims()
+{
+	TArray<FSmartObjectClaimHandle> StaleClaims;
+	{
+		FScopeLock ClaimsLock(&ClaimsByUserLock);
+		for (auto It = ClaimsByUser.CreateIterator(); It; ++It)
+		{
+			const AActor* User = Cast<AActor>(It.Key().ResolveObjectPtr());
+			const IDamageableInterface* Damageable = Cast<IDamageableInterface>(User);
+			if (IsValid(User) && (!Damageable || Damageable->IsAlive())) continue;
+
+			StaleClaims.Append(It.Value());
+			It.RemoveCurrent();
+		}
+		NumClaimUsers.store(ClaimsByUser.Num(), std::memory_order_relaxed);
+	}
+
+	if (StaleClaims.Num() > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("ShowcaseSmartObjectSubsystem: Released %d stale claims"), ReleaseAndNotify(StaleClaims));
+	}
+}
+
+int32 UShowcaseSmartObjectSubsystem::ReleaseAndNotify(TConstArrayView<FSmartObjectClaimHandle> Claims)
+{
+	int32 NumReleased = 0;
+	for (const FSmartObjectClaimHandle& Claim : Claims)
+	{
+		bool bReleased;
+		{
+			FReadScopeLock ReadLock(RegistryLock);
+			bReleased = ReleaseClaimLocked(Claim);
+		}
+
+		if (bReleased)
+		{
+			++NumReleased;
+			if (ASmartObject* SmartObject = GetSmartObject(Claim.RegistryId))
+			{
+				SmartObject->HandleClaimReleased(Claim);
+			}
+		}
+	}
+	return NumReleased;
+}
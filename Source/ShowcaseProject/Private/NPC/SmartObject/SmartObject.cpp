@@ -4,6 +4,7 @@
 #include "Components/ArrowComponent.h"
 #include "Components/SphereComponent.h"
 #include "NPC/Character/NPC_BaseCharacter.h"
+#include "NPC/SmartObject/ShowcaseSmartObjectSubsystem.h"
 #include "Player/ShowcaseProjectCharacter.h"
 
 
@@ -44,6 +45,36 @@ void ASmartObject::BeginPlay()
     }
 
     UpdateInteractionSphere();
+    RefreshRegistration();
+}
+
+void ASmartObject::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UShowcaseSmartObjectSubsystem* Registry = GetWorld()->GetSubsystem<UShowcaseSmartObjectSubsystem>())
+    {
+        Registry->UnregisterSmartObject(RegistryId);
+    }
+    RegistryId = INDEX_NONE;
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ASmartObject::RefreshRegistration()
+{
+    if (UShowcaseSmartObjectSubsystem* Registry = GetWorld()->GetSubsystem<UShowcaseSmartObjectSubsystem>())
+    {
+        Registry->UnregisterSmartObject(RegistryId);
+
+        // Claims on the old registration stop validating, the slot mirror starts over with them
+        UserClaims.Empty();
+        for (FInteractionSlot& Slot : InteractionSlots)
+        {
+            Slot.bIsOccupied = false;
+            Slot.CurrentUser = nullptr;
+        }
+
+        RegistryId = Registry->RegisterSmartObject(this);
+    }
 }
 
 bool ASmartObject::CanUserInteract(AActor* User) const
@@ -55,25 +86,25 @@ bool ASmartObject::CanUserInteract(AActor* User) const
     }
 
     // Check distance
-    if (GetDistanceToUser(User) > MaxInteractionDistance)
+    const float DistanceToUser = GetDistanceToUser(User);
+    if (DistanceToUser > MaxInteractionDistance)
     {
-        UE_LOG(LogTemp, Warning, TEXT("SmartObject %s: User %s is too far away"), *GetName(), *User->GetName());
-        // log distance
-        UE_LOG(LogTemp, Log, TEXT("Distance to user: %f, Max allowed: %f, Which results in %s"),
-            GetDistanceToUser(User), MaxInteractionDistance,
-            (GetDistanceToUser(User) > MaxInteractionDistance) ? TEXT("false") : TEXT("true"));
+        UE_LOG(LogTemp, Warning, TEXT("SmartObject %s: User %s is too far away (%f, max %f)"),
+            *GetName(), *User->GetName(), DistanceToUser, MaxInteractionDistance);
         return false;
     }
 
+    const int32 UserSlotIndex = GetSlotIndexForUser(User);
+
     // Check if there are available slots
-    if (GetAvailableSlotCount() == 0 && GetSlotIndexForUser(User) == INDEX_NONE)
+    if (UserSlotIndex == INDEX_NONE && GetFreeSlotMask() == 0)
     {
         UE_LOG(LogTemp, Warning, TEXT("SmartObject %s: No available slots for user %s"), *GetName(), *User->GetName());
         return false;
     }
 
     // Check if user already has a slot
-    if (GetSlotIndexForUser(User) != INDEX_NONE)
+    if (UserSlotIndex != INDEX_NONE)
     {
         UE_LOG(LogTemp, Log, TEXT("SmartObject %s: User %s already has a slot assigned"), *GetName(), *User->GetName());
         return true;
@@ -101,17 +132,17 @@ int32 ASmartObject::GetAvailableSlotIndex(AActor* RequestingActor) const
         }
     }
 
-    // Find the best available slot by priority
+    // Find the best available slot by priority, only the free ones are visited
     int32 BestSlotIndex = INDEX_NONE;
     int32 HighestPriority = 0;
 
-    for (int32 i = 0; i < InteractionSlots.Num(); ++i)
+    for (uint64 Remaining = GetFreeSlotMask(); Remaining; Remaining &= Remaining - 1)
     {
-        const FInteractionSlot& Slot = InteractionSlots[i];
-        if (!Slot.bIsOccupied && Slot.Priority > HighestPriority)
+        const int32 SlotIndex = static_cast<int32>(FMath::CountTrailingZeros64(Remaining));
+        if (InteractionSlots[SlotIndex].Priority > HighestPriority)
         {
-            BestSlotIndex = i;
-            HighestPriority = Slot.Priority;
+            BestSlotIndex = SlotIndex;
+            HighestPriority = InteractionSlots[SlotIndex].Priority;
         }
     }
 
@@ -125,9 +156,25 @@ bool ASmartObject::ReserveSlot(int32 SlotIndex, AActor* User)
         return false;
     }
 
-    FInteractionSlot& Slot = InteractionSlots[SlotIndex];
+    UShowcaseSmartObjectSubsystem* Registry = GetWorld()->GetSubsystem<UShowcaseSmartObjectSubsystem>();
+    if (!Registry)
+    {
+        return false;
+    }
 
-    if (Slot.bIsOccupied && Slot.CurrentUser != User)
+    // Already holds this slot
+    const FSmartObjectClaimHandle* ExistingClaim = UserClaims.Find(User);
+    if (ExistingClaim && ExistingClaim->SlotIndex == SlotIndex && Registry->IsClaimValid(*ExistingClaim))
+    {
+        return true;
+    }
+
+    FSmartObjectSlotRef SlotRef;
+    SlotRef.RegistryId = RegistryId;
+    SlotRef.SlotIndex = SlotIndex;
+
+    const FSmartObjectClaimHandle Claim = Registry->ClaimSlot(SlotRef, User);
+    if (!Claim.IsSet())
     {
         return false;
     }
@@ -135,10 +182,10 @@ bool ASmartObject::ReserveSlot(int32 SlotIndex, AActor* User)
     // Release any previous slot for this user
     ReleaseSlotByUser(User);
 
-    // Reserve the new slot
+    FInteractionSlot& Slot = InteractionSlots[SlotIndex];
     Slot.bIsOccupied = true;
     Slot.CurrentUser = User;
-    UserSlotAssignments.Add(User, SlotIndex);
+    UserClaims.Add(User, Claim);
 
     UE_LOG(LogTemp, Log, TEXT("SmartObject %s: Slot %d reserved by %s"),
         *GetName(), SlotIndex, *User->GetName());
@@ -148,15 +195,35 @@ bool ASmartObject::ReserveSlot(int32 SlotIndex, AActor* User)
 
 void ASmartObject::ReleaseSlotByUser(AActor* User)
 {
-    if (!User)
+    FSmartObjectClaimHandle Claim;
+    if (!User || !UserClaims.RemoveAndCopyValue(User, Claim))
+    {
+        return;
+    }
+
+    // A dead handle means the slot may already belong to someone else, their mirror stays as it is
+    UShowcaseSmartObjectSubsystem* Registry = GetWorld()->GetSubsystem<UShowcaseSmartObjectSubsystem>();
+    if (!Registry || !Registry->ReleaseClaim(Claim))
     {
         return;
     }
 
-    int32 SlotIndex = GetSlotIndexForUser(User);
-    if (SlotIndex != INDEX_NONE)
+    UE_LOG(LogTemp, Log, TEXT("SmartObject %s: Slot %d released by %s"),
+        *GetName(), Claim.SlotIndex, *User->GetName());
+
+    ReleaseSlot(Claim.SlotIndex);
+}
+
+void ASmartObject::HandleClaimReleased(const FSmartObjectClaimHandle& Claim)
+{
+    for (auto It = UserClaims.CreateIterator(); It; ++It)
     {
-        ReleaseSlot(SlotIndex);
+        if (It.Value() == Claim)
+        {
+            It.RemoveCurrent();
+            ReleaseSlot(Claim.SlotIndex);
+            return;
+        }
     }
 }
 
@@ -168,14 +235,6 @@ void ASmartObject::ReleaseSlot(int32 SlotIndex)
     }
 
     FInteractionSlot& Slot = InteractionSlots[SlotIndex];
-
-    if (Slot.CurrentUser)
-    {
-        UserSlotAssignments.Remove(Slot.CurrentUser);
-        UE_LOG(LogTemp, Log, TEXT("SmartObject %s: Slot %d released by %s"),
-            *GetName(), SlotIndex, *Slot.CurrentUser->GetName());
-    }
-
     Slot.bIsOccupied = false;
     Slot.CurrentUser = nullptr;
 }
@@ -204,15 +263,28 @@ FRotator ASmartObject::GetSlotWorldRotation(int32 SlotIndex) const
 
 int32 ASmartObject::GetAvailableSlotCount() const
 {
-    int32 Count = 0;
-    for (const FInteractionSlot& Slot : InteractionSlots)
+    return FMath::CountBits(GetFreeSlotMask());
+}
+
+uint64 ASmartObject::GetFreeSlotMask() const
+{
+    const UWorld* World = GetWorld();
+    const UShowcaseSmartObjectSubsystem* Registry = World ? World->GetSubsystem<UShowcaseSmartObjectSubsystem>() : nullptr;
+    if (Registry && RegistryId != INDEX_NONE)
+    {
+        return Registry->GetFreeSlots(RegistryId);
+    }
+
+    // Not registered yet, e.g. in the editor
+    uint64 FreeSlots = 0;
+    for (int32 SlotIndex = 0; SlotIndex < FMath::Min(InteractionSlots.Num(), UShowcaseSmartObjectSubsystem::MaxSlots); ++SlotIndex)
     {
-        if (!Slot.bIsOccupied)
+        if (!InteractionSlots[SlotIndex].bIsOccupied)
         {
-            Count++;
+            FreeSlots |= (1ull << SlotIndex);
         }
     }
-    return Count;
+    return FreeSlots;
 }
 
 void ASmartObject::GenerateDefaultSlots()
@@ -309,11 +381,14 @@ bool ASmartObject::IsUserValid(AActor* User) const
 
 int32 ASmartObject::GetSlotIndexForUser(AActor* User) const
 {
-    if (const int32* SlotIndex = UserSlotAssignments.Find(User))
+    const FSmartObjectClaimHandle* Claim = UserClaims.Find(User);
+    if (!Claim)
     {
-        return *SlotIndex;
+        return INDEX_NONE;
     }
-    return INDEX_NONE;
+
+    const UShowcaseSmartObjectSubsystem* Registry = GetWorld()->GetSubsystem<UShowcaseSmartObjectSubsystem>();
+    return Registry && Registry->IsClaimValid(*Claim) ? Claim->SlotIndex : INDEX_NONE;
 }
 
 void ASmartObject::BeginFocus() { IInteractionInterface::BeginFocus(); }
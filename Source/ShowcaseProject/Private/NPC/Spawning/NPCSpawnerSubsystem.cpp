@@ -0,0 +1,191 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NPC/Spawning/NPCSpawnerSubsystem.h"
+
+#include "Engine/GameInstance.h"
+#include "NPC/Archetype/NPCArchetypeSubsystem.h"
+#include "NPC/Character/NPC_BaseCharacter.h"
+
+void UNPCSpawnerSubsystem::Deinitialize()
+{
+	Pools.Empty();
+	Queue.Empty();
+
+	Super::Deinitialize();
+}
+
+void UNPCSpawnerSubsystem::RequestSpawn(TSubclassOf<ANPC_BaseCharacter> NPCClass, const FDataTableRowHandle& NPCDataHandle, const FTransform& Transform,
+	FOnNPCSpawned OnSpawned)
+{
+	if (!NPCClass) return;
+
+	FNPCSpawnRequest& Request = Queue.AddDefaulted_GetRef();
+	Request.NPCClass = NPCClass;
+	Request.NPCDataHandle = NPCDataHandle;
+	Request.Transform = Transform;
+	Request.OnSpawned = MoveTemp(OnSpawned);
+}
+
+void UNPCSpawnerSubsystem::Prewarm(TSubclassOf<ANPC_BaseCharacter> NPCClass, const FDataTableRowHandle& NPCDataHandle, int32 Count)
+{
+	if (!NPCClass) return;
+
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		FNPCSpawnRequest& Request = Queue.AddDefaulted_GetRef();
+		Request.NPCClass = NPCClass;
+		Request.NPCDataHandle = NPCDataHandle;
+		Request.bPoolOnly = true;
+	}
+}
+
+ANPC_BaseCharacter* UNPCSpawnerSubsystem::AcquireNPC(TSubclassOf<ANPC_BaseCharacter> NPCClass, const FDataTableRowHandle& NPCDataHandle, const FTransform& Transform)
+{
+	if (!NPCClass) return nullptr;
+
+	if (ANPC_BaseCharacter* Pooled = TakeFromPool(GetPoolKey(NPCClass, NPCDataHandle)))
+	{
+		Pooled->ResetForRespawn(Transform);
+		return Pooled;
+	}
+
+	return SpawnNew(NPCClass, NPCDataHandle, Transform);
+}
+
+void UNPCSpawnerSubsystem::ReleaseNPC(ANPC_BaseCharacter* NPC)
+{
+	if (!NPC) return;
+
+	TArray<TWeakObjectPtr<ANPC_BaseCharacter>>& Pool = Pools.FindOrAdd(FNPCPoolKey(NPC->GetClass(), NPC->GetArchetype()));
+	Pool.RemoveAllSwap([](const TWeakObjectPtr<ANPC_BaseCharacter>& Pooled) { return !Pooled.IsValid(); });
+	if (Pool.Num() >= MaxPooledPerArchetype)
+	{
+		// Destroying the pawn also destroys its AI controller
+		NPC->Destroy();
+		return;
+	}
+
+	NPC->DeactivateForPool();
+	Pool.Add(NPC);
+
+	UE_LOG(LogTemp, Verbose, TEXT("NPCSpawnerSubsystem: Pooled %s, %d in its pool"), *NPC->GetName(), Pool.Num());
+}
+
+int32 UNPCSpawnerSubsystem::GetNumPooled() const
+{
+	int32 Count = 0;
+	for (const TPair<FNPCPoolKey, TArray<TWeakObjectPtr<ANPC_BaseCharacter>>>& Pool : Pools)
+	{
+		Count += Pool.Value.Num();
+	}
+	return Count;
+}
+
+void UNPCSpawnerSubsystem::Tick(float DeltaTime)
+{
+	int32 NumNew = 0;
+	int32 NumRespawned = 0;
+
+	int32 NumServed = 0;
+	for (; NumServed < Queue.Num(); ++NumServed)
+	{
+		FNPCSpawnRequest& Request = Queue[NumServed];
+		ANPC_BaseCharacter* NPC = nullptr;
+
+		if (!Request.bPoolOnly && NumRespawned < MaxRespawnsPerFrame)
+		{
+			NPC = TakeFromPool(GetPoolKey(Request.NPCClass, Request.NPCDataHandle));
+			if (NPC)
+			{
+				NPC->ResetForRespawn(Request.Transform);
+				++NumRespawned;
+			}
+		}
+
+		if (!NPC)
+		{
+			// Out of budget, the rest of the queue waits for the next frame
+			if (NumNew >= MaxNewSpawnsPerFrame) break;
+
+			NPC = SpawnNew(Request.NPCClass, Request.NPCDataHandle, Request.Transform);
+			++NumNew;
+
+			if (NPC && Request.bPoolOnly)
+			{
+				ReleaseNPC(NPC);
+				continue;
+			}
+		}
+
+		// The callback may queue more spawns and move the queue
+		const FOnNPCSpawned OnSpawned = MoveTemp(Request.OnSpawned);
+		OnSpawned.ExecuteIfBound(NPC);
+	}
+
+	Queue.RemoveAt(0, NumServed, EAllowShrinking::No);
+
+	if (NumServed > 0)
+	{
+		UE_LOG(LogTemp, VeryVerbose, TEXT("NPCSpawnerSubsystem: Served %d spawns (%d new, %d from pool), %d queued"), NumServed, NumNew, NumRespawned, Queue.Num());
+	}
+}
+
+bool UNPCSpawnerSubsystem::IsTickable() const
+{
+	return Queue.Num() > 0;
+}
+
+TStatId UNPCSpawnerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNPCSpawnerSubsystem, STATGROUP_Tickables);
+}
+
+UNPCSpawnerSubsystem::FNPCPoolKey UNPCSpawnerSubsystem::GetPoolKey(TSubclassOf<ANPC_BaseCharacter> NPCClass, const FDataTableRowHandle& NPCDataHandle) const
+{
+	// Same lookup the NPC does in InitializeFromDataTable, so the keys of released and requested NPCs agree
+	const UGameInstance* GameInstance = GetWorld()->GetGameInstance();
+	UNPCArchetypeSubsystem* Archetypes = GameInstance ? GameInstance->GetSubsystem<UNPCArchetypeSubsystem>() : nullptr;
+
+	const UNPCArchetype* Archetype = nullptr;
+	if (Archetypes)
+	{
+		Archetype = Archetypes->GetOrCreateArchetype(NPCDataHandle);
+		if (!Archetype)
+		{
+			Archetype = Archetypes->GetDefaultArchetype();
+		}
+	}
+
+	return FNPCPoolKey(NPCClass.Get(), Archetype);
+}
+
+ANPC_BaseCharacter* UNPCSpawnerSubsystem::TakeFromPool(const FNPCPoolKey& Key)
+{
+	TArray<TWeakObjectPtr<ANPC_BaseCharacter>>* Pool = Pools.Find(Key);
+	while (Pool && Pool->Num() > 0)
+	{
+		if (ANPC_BaseCharacter* NPC = Pool->Pop(EAllowShrinking::No).Get())
+		{
+			return NPC;
+		}
+	}
+	return nullptr;
+}
+
+ANPC_BaseCharacter* UNPCSpawnerSubsystem::SpawnNew(TSubclassOf<ANPC_BaseCharacter> NPCClass, const FDataTableRowHandle& NPCDataHandle, const FTransform& Transform)
+{
+	ANPC_BaseCharacter* NPC = GetWorld()->SpawnActorDeferred<ANPC_BaseCharacter>(NPCClass, Transform, nullptr, nullptr,
+		ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	if (!NPC) return nullptr;
+
+	NPC->NPCDataHandle = NPCDataHandle;
+	NPC->FinishSpawning(Transform);
+
+	if (!NPC->GetController())
+	{
+		NPC->SpawnDefaultController();
+	}
+
+	return NPC;
+}
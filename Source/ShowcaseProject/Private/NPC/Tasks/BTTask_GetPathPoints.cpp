@@ -4,6 +4,7 @@
 #include "NPC/Tasks/BTTask_GetPathPoints.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "BrainComponent.h"
 #include "NPC/Controller/NPC_AIController.h"
 #include "NPC/Character/NPC_BaseCharacter.h"
 #include "NPC/PatrolPath/PatrolPath.h"
@@ -23,22 +24,77 @@ EBTNodeResult::Type UBTTask_GetPathPoints::ExecuteTask(UBehaviorTreeComponent& O
 		{
 			if (UBlackboardComponent* Blackboard = OwnerComp.GetBlackboardComponent())
 			{
-				// Check if the smart object is a PatrolPath
-				// if (APatrolPath* PatrolPath = Cast<APatrolPath>(NPCCharacter->CurrentSmartObject))
-				// {
-				// 	int32 const Index = Blackboard->GetValueAsInt(GetSelectedBlackboardKey());
-				//
-				// 	FVector PathPoint = PatrolPath->GetPatrolPoint(Index);
-				//
-				// 	UE::Math::TVector<double> const GlobalPoint = PatrolPath->GetActorTransform().TransformPosition(PathPoint);
-				//
-				// 	Blackboard->SetValueAsVector(MoveToLocationVectorKey.SelectedKeyName, GlobalPoint);
-				//
-				// 	FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
-				// 	return EBTNodeResult::Succeeded;
-				// }
+				if (APatrolPath* PatrolPath = NPCCharacter->PatrolPath)
+				{
+					if (PatrolPath->Num() == 0) return EBTNodeResult::Failed;
+
+					int32 const Index = Blackboard->GetValueAsInt(GetSelectedBlackboardKey());
+					Blackboard->SetValueAsVector(MoveToLocationVectorKey.SelectedKeyName, PatrolPath->GetPatrolPointLocation(Index));
+
+					if (!bMoveAlongCachedPath) return EBTNodeResult::Succeeded;
+
+					return MoveToPatrolPoint(OwnerComp, *Controller, *PatrolPath, Index);
+				}
 			}
 		}
 	}
 	return EBTNodeResult::Failed;
 }
+
+EBTNodeResult::Type UBTTask_GetPathPoints::MoveToPatrolPoint(UBehaviorTreeComponent& OwnerComp, ANPC_AIController& Controller, APatrolPath& PatrolPath, int32 Index)
+{
+	// The shared path starts at the previous patrol point, an NPC anywhere else pathfinds from where it stands
+	FNavPathSharedPtr LegPath;
+	if (LastReachedIndex != INDEX_NONE && LastReachedIndex != Index
+		&& FVector::DistSquared2D(Controller.GetPawn()->GetActorLocation(), PatrolPath.GetPatrolPointLocation(LastReachedIndex)) <= FMath::Square(LegStartTolerance))
+	{
+		LegPath = PatrolPath.GetLegPath(LastReachedIndex, Index);
+	}
+
+	FAIMoveRequest MoveRequest(PatrolPath.GetPatrolPointLocation(Index));
+	MoveRequest.SetAcceptanceRadius(AcceptanceRadius);
+
+	FAIRequestID MoveId;
+	if (LegPath.IsValid())
+	{
+		MoveId = Controller.RequestMove(MoveRequest, LegPath);
+	}
+	else
+	{
+		const FPathFollowingRequestResult Result = Controller.MoveTo(MoveRequest);
+		if (Result.Code == EPathFollowingRequestResult::AlreadyAtGoal)
+		{
+			LastReachedIndex = Index;
+			return EBTNodeResult::Succeeded;
+		}
+		MoveId = Result.MoveId;
+	}
+
+	if (!MoveId.IsValid())
+	{
+		LastReachedIndex = INDEX_NONE;
+		return EBTNodeResult::Failed;
+	}
+
+	PendingIndex = Index;
+	WaitForMessage(OwnerComp, UBrainComponent::AIMessage_MoveFinished, MoveId.GetID());
+	return EBTNodeResult::InProgress;
+}
+
+EBTNodeResult::Type UBTTask_GetPathPoints::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	if (AAIController* Controller = OwnerComp.GetAIOwner())
+	{
+		Controller->StopMovement();
+	}
+	LastReachedIndex = INDEX_NONE;
+	return EBTNodeResult::Aborted;
+}
+
+void UBTTask_GetPathPoints::OnMessage(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, FName Message, int32 RequestID, bool bSuccess)
+{
+	// Only an NPC that arrived can start the next leg on the shared path
+	LastReachedIndex = bSuccess ? PendingIndex : INDEX_NONE;
+
+	Super::OnMessage(OwnerComp, NodeMemory, Message, RequestID, bSuccess);
+}
@@ -12,6 +12,16 @@ UBTTask_IncrementPathIndex::UBTTask_IncrementPathIndex(const FObjectInitializer&
 	NodeName = TEXT("Increment Path Index");
 }
 
+void UBTTask_IncrementPathIndex::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FBTIncrementPathIndexMemory>(NodeMemory, InitType);
+}
+
+void UBTTask_IncrementPathIndex::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const
+{
+	CleanupNodeMemory<FBTIncrementPathIndexMemory>(NodeMemory, CleanupType);
+}
+
 EBTNodeResult::Type UBTTask_IncrementPathIndex::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
 
@@ -21,29 +31,33 @@ EBTNodeResult::Type UBTTask_IncrementPathIndex::ExecuteTask(UBehaviorTreeCompone
 		{
 			if (UBlackboardComponent* Blackboard = OwnerComp.GetBlackboardComponent())
 			{
-				// Check if the SmartObject is a PatrolPath
-				// if (APatrolPath* PatrolPath = Cast<APatrolPath>(Character->CurrentSmartObject))
-				// {
-				// 	int const NoOfPoints = PatrolPath->Num();
-				// 	int const MinIndex = 0;
-				// 	int const MaxIndex = NoOfPoints - 1;
-				// 	int Index = Blackboard->GetValueAsInt(GetSelectedBlackboardKey());
-				// 	if (bBiDirectional)
-				// 	{
-				// 		if (Index >= MaxIndex && Direction == EDirectionType::Forward)
-				// 		{
-				// 			Direction = EDirectionType::Backward;
-				// 		}
-				// 		else if (Index <= MinIndex && Direction == EDirectionType::Backward)
-				// 		{
-				// 			Direction = EDirectionType::Forward;
-				// 		}
-				// 	}
-				// 	Blackboard->SetValueAsInt(GetSelectedBlackboardKey(),
-				// 		(Direction == EDirectionType::Forward ? ++Index : --Index) % NoOfPoints);
-				// 	FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
-				// 	return EBTNodeResult::Succeeded;
-				// }
+				if (const APatrolPath* PatrolPath = Character->PatrolPath)
+				{
+					int const NoOfPoints = PatrolPath->Num();
+					if (NoOfPoints == 0) return EBTNodeResult::Failed;
+
+					int const MinIndex = 0;
+					int const MaxIndex = NoOfPoints - 1;
+					int const Index = Blackboard->GetValueAsInt(GetSelectedBlackboardKey());
+
+					EDirectionType& Direction = CastInstanceNodeMemory<FBTIncrementPathIndexMemory>(NodeMemory)->Direction;
+					if (bBiDirectional)
+					{
+						if (Index >= MaxIndex && Direction == EDirectionType::Forward)
+						{
+							Direction = EDirectionType::Backward;
+						}
+						else if (Index <= MinIndex && Direction == EDirectionType::Backward)
+						{
+							Direction = EDirectionType::Forward;
+						}
+					}
+
+					// Each step is one leg APatrolPath has a shared path for, forwards or reversed
+					int const Step = Direction == EDirectionType::Forward ? 1 : -1;
+					Blackboard->SetValueAsInt(GetSelectedBlackboardKey(), (Index + Step + NoOfPoints) % NoOfPoints);
+					return EBTNodeResult::Succeeded;
+				}
 			}
 		}
 	}
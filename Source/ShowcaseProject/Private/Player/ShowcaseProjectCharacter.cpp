@@ -12,7 +12,11 @@
 #include "InputActionValue.h"
 #include "DrawDebugHelpers.h"
 #include "Animation/ShowcaseAnimInstance.h"
+#include "Components/AimComponent/AimComponent.h"
 #include "Components/InventoryComponent/InventoryComponent.h"
+#include "Dialogue/Facts/DialogueFactSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "NPC/Perception/NPCPerceptionSubsystem.h"
 #include  "Components/WeaponSystemComponent/WeaponSystemComponent.h"
 #include "UserInterface/ShowcaseHUD/ShowcaseHUD.h"
 #include "Perception/AIPerceptionStimuliSourceComponent.h"
@@ -73,6 +77,8 @@ AShowcaseProjectCharacter::AShowcaseProjectCharacter()
 
 	WeaponSystemComponent = CreateDefaultSubobject<UWeaponSystemComponent>(TEXT("WeaponSystemComponent_New"));
 
+	AimComponent = CreateDefaultSubobject<UAimComponent>(TEXT("AimComponent"));
+
 	SetupStimuliSource();
 }
 
@@ -159,6 +165,24 @@ void AShowcaseProjectCharacter::BeginPlay()
 	Super::BeginPlay();
 	AnimInstance = Cast<UShowcaseAnimInstance>(GetMesh()->GetAnimInstance());
 	HUD = Cast<AShowcaseHUD>(GetWorld()->GetFirstPlayerController()->GetHUD());
+
+	// Let the crosshair react to whatever the shared aim trace lands on
+	if (HUD && AimComponent)
+	{
+		AimComponent->OnAimTargetChanged.AddUObject(HUD, &AShowcaseHUD::OnAimTargetChanged);
+	}
+
+	// Dialogue conditions read item counts from the fact store, keep it in sync with our inventory
+	if (UDialogueFactSubsystem* DialogueFacts = GetGameInstance()->GetSubsystem<UDialogueFactSubsystem>())
+	{
+		DialogueFacts->BindInventory(PlayerInventory);
+	}
+
+	// NPC sight is checked against registered targets, destroyed targets drop out on their own
+	if (UNPCPerceptionSubsystem* Perception = GetWorld()->GetSubsystem<UNPCPerceptionSubsystem>())
+	{
+		Perception->RegisterSightTarget(this);
+	}
 }
 
 void AShowcaseProjectCharacter::PerformInteractionCheck()
@@ -313,7 +337,7 @@ void AShowcaseProjectCharacter::BeginAim()
 		// Show weapon HUD when aiming
 		if (HUD && WeaponSystemComponent->GetEquippedWeapon())
 		{
-			HUD->GetWeaponHUD()->StartAiming();
+			HUD->OnWeaponAimStart();
 		}
 		UE_LOG(LogTemplateCharacter, Log, TEXT("Started aiming"));
 	}
@@ -339,41 +363,20 @@ void AShowcaseProjectCharacter::EndAim()
 		// Hide weapon HUD when stopping aim
 		if (HUD && WeaponSystemComponent->GetEquippedWeapon())
 		{
-			HUD->GetWeaponHUD()->StopAiming();
-			HUD->GetWeaponHUD()->HideCrosshair();
+			HUD->OnWeaponAimStop();
 		}
 		
 		UE_LOG(LogTemplateCharacter, Log, TEXT("Stopped aiming"));
 	}
 }
 
-void AShowcaseProjectCharacter::UpdateCrosshairDirection()
-{
-	if (const APlayerController* PC = Cast<APlayerController>(GetController()))
-	{
-		// Get viewport size
-		FVector2D ViewportSize;
-		GetWorld()->GetGameViewport()->GetViewportSize(ViewportSize);
-		const FVector2D CrosshairScreenPosition = ViewportSize * 0.5f;
-
-		// Convert crosshair screen position to world space
-		FVector CrosshairWorldLocation;
-		PC->DeprojectScreenPositionToWorld(
-			CrosshairScreenPosition.X,
-			CrosshairScreenPosition.Y,
-			CrosshairWorldLocation,
-			CrosshairWorldDirection
-		);
-	}
-}
-
 void AShowcaseProjectCharacter::RotateTowardsCrosshair(float RotationSpeed, float DeltaTime)
 {
-	UpdateCrosshairDirection();
+	if (!AimComponent) return;
 
-	// Calculate target location in world space
+	// Calculate target location in world space from this frame's shared crosshair ray
 	const FVector CharacterLocation = GetActorLocation();
-	const FVector TargetLocation = CharacterLocation + (CrosshairWorldDirection * 1000.0f);
+	const FVector TargetLocation = CharacterLocation + (AimComponent->GetAimState().RayDirection * 1000.0f);
 
 	// Calculate direction from character to target (only use X and Y for yaw rotation)
 	FVector DirectionToTarget = (TargetLocation - CharacterLocation).GetSafeNormal();
@@ -15,7 +15,6 @@ UChoiceButton::UChoiceButton(const FObjectInitializer& ObjectInitializer)
     , ChoiceIndex(-1)
     , bIsInitialized(false)
 {
-    UE_LOG(LogTemp, Warning, TEXT("ChoiceButton: Creating fallback widgets due to binding failures"));
 }
 
 void UChoiceButton::NativePreConstruct()
@@ -27,9 +26,9 @@ void UChoiceButton::NativePreConstruct()
     UE_LOG(LogTemp, VeryVerbose, TEXT("ChoiceButton: NativePreConstruct called"));
 }
 
-void UChoiceButton::NativeConstruct()
+void UChoiceButton::NativeOnInitialized()
 {
-    Super::NativeConstruct();
+    Super::NativeOnInitialized();
 
     // Widget binding validation with detailed logging
     bool bHasValidBindings = true;
@@ -69,7 +68,7 @@ void UChoiceButton::NativeConstruct()
         
         // Add the new binding
         InternalButton->OnClicked.AddDynamic(this, &UChoiceButton::HandleInternalClick);
-        UE_LOG(LogTemp, Log, TEXT("ChoiceButton: Button click delegate bound"));
+        UE_LOG(LogTemp, VeryVerbose, TEXT("ChoiceButton: Button click delegate bound"));
     }
     else
     {
@@ -80,7 +79,7 @@ void UChoiceButton::NativeConstruct()
     ConfigureWidgetStyling();
     bIsInitialized = true;
 
-    UE_LOG(LogTemp, Log, TEXT("ChoiceButton: NativeConstruct completed successfully"));
+    UE_LOG(LogTemp, Verbose, TEXT("ChoiceButton: Initialized"));
 }
 
 void UChoiceButton::CreateFallbackWidgets()
@@ -151,7 +150,7 @@ void UChoiceButton::ConfigureWidgetStyling()
         FontInfo.Size = TextSize;
         ChoiceTextBlock->SetFont(FontInfo);
 
-        UE_LOG(LogTemp, Log, TEXT("ChoiceButton: Styling applied - Text: %s, Size: %d"), 
+        UE_LOG(LogTemp, VeryVerbose, TEXT("ChoiceButton: Styling applied - Text: %s, Size: %d"), 
                *DefaultChoiceText.ToString(), TextSize);
     }
 
@@ -165,26 +164,32 @@ void UChoiceButton::ConfigureWidgetStyling()
 void UChoiceButton::SetChoiceIndex(int32 InChoiceIndex)
 {
     ChoiceIndex = InChoiceIndex;
-    UE_LOG(LogTemp, Log, TEXT("ChoiceButton: Index set to %d"), ChoiceIndex);
+    UE_LOG(LogTemp, VeryVerbose, TEXT("ChoiceButton: Index set to %d"), ChoiceIndex);
 }
 
 void UChoiceButton::InitializeChoiceButton(int32 InChoiceIndex, const FText& ChoiceText)
 {
     SetChoiceIndex(InChoiceIndex);
     SetChoiceText(ChoiceText);
-    UE_LOG(LogTemp, Log, TEXT("ChoiceButton: Initialized with index %d and text: %s"), 
+    UE_LOG(LogTemp, VeryVerbose, TEXT("ChoiceButton: Initialized with index %d and text: %s"), 
            InChoiceIndex, *ChoiceText.ToString());
 }
 
 void UChoiceButton::SetChoiceText(const FText& InText)
 {
+    // Pooled buttons often get the same line again, skip the text invalidation then
+    if (bIsInitialized && InText.IdenticalTo(DefaultChoiceText))
+    {
+        return;
+    }
+
     // Always store the text for later use
     DefaultChoiceText = InText;
 
     if (ChoiceTextBlock)
     {
         ChoiceTextBlock->SetText(InText);
-        UE_LOG(LogTemp, Log, TEXT("ChoiceButton: Text set to: %s"), *InText.ToString());
+        UE_LOG(LogTemp, VeryVerbose, TEXT("ChoiceButton: Text set to: %s"), *InText.ToString());
     }
     else
     {
@@ -199,7 +204,7 @@ void UChoiceButton::HandleInternalClick()
 {
     if (ChoiceIndex >= 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("ChoiceButton[%d]: Broadcasting click event"), ChoiceIndex);
+        UE_LOG(LogTemp, Verbose, TEXT("ChoiceButton[%d]: Broadcasting click event"), ChoiceIndex);
         OnChoiceButtonClicked.Broadcast(this, ChoiceIndex);
     }
     else
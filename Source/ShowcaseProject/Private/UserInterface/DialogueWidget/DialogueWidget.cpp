@@ -5,12 +5,42 @@
 
 #include "Blueprint/WidgetTree.h"
 #include "Components/DialogueComponent/DialogueComponent.h"
+#include "Dialogue/Graph/DialogueGraph.h"
 #include "Components/TextBlock.h"
 #include "Components/VerticalBox.h"
 #include "Components/Button.h"
 #include "Components/VerticalBoxSlot.h"
 #include "UserInterface/ChoiceButton/ChoiceButton.h"
 
+void UDialogueWidget::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	// One-time cost: every button the widget will normally need is created and styled here
+	if (ChoicesContainer && ChoiceButtonClass)
+	{
+		ChoiceButtons.Reserve(ChoiceButtonPoolSize);
+		for (int32 i = 0; i < ChoiceButtonPoolSize; ++i)
+		{
+			AddPooledChoiceButton();
+		}
+	}
+}
+
+UChoiceButton* UDialogueWidget::AddPooledChoiceButton()
+{
+	UChoiceButton* ChoiceButton = CreateWidget<UChoiceButton>(this, ChoiceButtonClass);
+	if (!ChoiceButton) return nullptr;
+
+	ChoiceButton->OnChoiceButtonClicked.AddDynamic(this, &UDialogueWidget::HandleChoiceButtonClicked);
+	ChoiceButton->SetVisibility(ESlateVisibility::Collapsed);
+
+	ChoicesContainer->AddChild(ChoiceButton);
+	ApplyChoiceButtonStyling(ChoiceButton);
+	ChoiceButtons.Add(ChoiceButton);
+	return ChoiceButton;
+}
+
 void UDialogueWidget::NativeConstruct()
 {
 	Super::NativeConstruct();
@@ -26,7 +56,7 @@ void UDialogueWidget::NativeDestruct()
 	UE_LOG(LogTemp, Log, TEXT("DialogueWidget: NativeDestruct called"));
 	// Critical: Clean up all references before destruction
 	CleanupDialogueBinding();
-	CleanupChoiceButtons();
+	HideChoiceButtons();
 	Super::NativeDestruct();
 }
 
@@ -50,29 +80,27 @@ void UDialogueWidget::CleanupDialogueBinding()
 	WeakDialogueComponent.Reset();
 }
 
-void UDialogueWidget::CleanupChoiceButtons()
+void UDialogueWidget::HideChoiceButtons()
 {
-	// Unbind delegates from existing choice buttons
-	for (UChoiceButton* Button : ChoiceButtons)
+	// Buttons stay in the container for the next node, only the ones in use get collapsed
+	for (int32 i = 0; i < NumActiveChoiceButtons && i < ChoiceButtons.Num(); ++i)
 	{
-		if (IsValid(Button))
+		if (IsValid(ChoiceButtons[i]))
 		{
-			Button->OnChoiceButtonClicked.RemoveAll(this);
+			ChoiceButtons[i]->SetVisibility(ESlateVisibility::Collapsed);
 		}
 	}
-
-	// Clear the container and array
-	if (ChoicesContainer)
-	{
-		ChoicesContainer->ClearChildren();
-	}
-    
-	ChoiceButtons.Empty();
-	UE_LOG(LogTemp, Log, TEXT("DialogueWidget: Choice buttons cleaned up"));
+	NumActiveChoiceButtons = 0;
 }
 
 void UDialogueWidget::SetDialogueComponent(UDialogueComponent* InDialogueComponent)
 {
+	// The HUD hands over the component on every node, keep the existing binding for the same conversation
+	if (bIsDialogueComponentBound && InDialogueComponent && WeakDialogueComponent.Get() == InDialogueComponent)
+	{
+		return;
+	}
+
 	// Clean up existing binding first
 	CleanupDialogueBinding();
 	
@@ -112,9 +140,12 @@ void UDialogueWidget::SetDialogueComponent(UDialogueComponent* InDialogueCompone
 
 void UDialogueWidget::DisplayDialogueNode(const FDialogueNode& DialogueNode)
 {
-	if (!bIsDialogueComponentBound || !WeakDialogueComponent.IsValid())
+	// The NPC can be pooled or destroyed mid-conversation, the HUD may still forward its last node
+	const UDialogueComponent* DialogueComponent = bIsDialogueComponentBound ? WeakDialogueComponent.Get() : nullptr;
+	if (!DialogueComponent)
 	{
 		UE_LOG(LogTemp, Error, TEXT("DialogueWidget: Cannot display - dialogue component not bound"));
+		HideChoiceButtons();
 		return;
 	}
 
@@ -130,38 +161,44 @@ void UDialogueWidget::DisplayDialogueNode(const FDialogueNode& DialogueNode)
 		DialogueText->SetText(DialogueNode.DialogueText);
 	}
 
-	CleanupChoiceButtons();
+	// Choices live in the compiled graph, the node passed in only carries presentation data
+	const UDialogueGraph* DialogueGraph = DialogueComponent->GetDialogueGraph();
+	const TConstArrayView<FDialogueGraphChoice> Choices = DialogueGraph ? DialogueGraph->GetChoices(DialogueComponent->CurrentNodeIndex) : TConstArrayView<FDialogueGraphChoice>();
+	const FDialogueChoiceSet& ValidChoices = DialogueComponent->GetValidChoices();
 
-	// Create choice buttons if we have choices
-	if (ChoicesContainer && DialogueNode.Choices.Num() > 0)
+	// Re-bind pooled buttons to the choices whose conditions passed, each keeps its index into the node's choices
+	int32 NumBound = 0;
+	if (ChoicesContainer && ChoiceButtonClass)
 	{
-		// Validate that we have a choice button class configured
-		if (!ChoiceButtonClass)
+		ValidChoices.ForEach([this, &Choices, &NumBound](int32 ChoiceIndex)
 		{
-			UE_LOG(LogTemp, Error, TEXT("DialogueWidget: ChoiceButtonClass not set! Please configure it in the Blueprint."));
-			return;
-		}
-
-		for (int32 i = 0; i < DialogueNode.Choices.Num(); ++i)
-		{
-			const FDialogueChoice& Choice = DialogueNode.Choices[i];
-
-			// This will now create the Blueprint widget, not the raw C++ class
-			if (UChoiceButton* ChoiceButton = CreateWidget<UChoiceButton>(GetWorld(), ChoiceButtonClass))
+			if (NumBound >= ChoiceButtons.Num())
 			{
-				ChoiceButton->InitializeChoiceButton(i, Choice.ChoiceText);
-				ChoiceButton->OnChoiceButtonClicked.AddDynamic(this, &UDialogueWidget::HandleChoiceButtonClicked);
-
-				ChoicesContainer->AddChild(ChoiceButton);
-				ChoiceButtons.Add(ChoiceButton);
+				UE_LOG(LogTemp, Warning, TEXT("DialogueWidget: Node offers more than %d choices, growing the button pool"), ChoiceButtons.Num());
+				if (!AddPooledChoiceButton()) return;
+			}
 
-				UE_LOG(LogTemp, Log, TEXT("DialogueWidget: Created choice button %d with text: %s"), 
-					   i, *Choice.ChoiceText.ToString());
+			UChoiceButton* ChoiceButton = ChoiceButtons[NumBound++];
+			ChoiceButton->InitializeChoiceButton(ChoiceIndex, Choices[ChoiceIndex].ChoiceText);
+			if (ChoiceButton->GetVisibility() != ESlateVisibility::Visible)
+			{
+				ChoiceButton->SetVisibility(ESlateVisibility::Visible);
 			}
-		}
+		});
+	}
+	else if (!ValidChoices.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("DialogueWidget: ChoiceButtonClass not set! Please configure it in the Blueprint."));
+	}
 
-		UE_LOG(LogTemp, Log, TEXT("DialogueWidget: Created %d choice buttons"), ChoiceButtons.Num());
+	// Collapse buttons the previous node used but this one does not
+	for (int32 i = NumBound; i < NumActiveChoiceButtons && i < ChoiceButtons.Num(); ++i)
+	{
+		ChoiceButtons[i]->SetVisibility(ESlateVisibility::Collapsed);
 	}
+	NumActiveChoiceButtons = NumBound;
+
+	UE_LOG(LogTemp, VeryVerbose, TEXT("DialogueWidget: Bound %d choice buttons"), NumBound);
 
 	OnDialogueDisplayed(DialogueNode);
 }
@@ -190,13 +227,13 @@ void UDialogueWidget::ApplyChoiceButtonStyling(UChoiceButton* ChoiceButton)
 void UDialogueWidget::HideDialogueNode()
 {
 	SetVisibility(ESlateVisibility::Hidden);
-	CleanupChoiceButtons();
-	UE_LOG(LogTemp, Log, TEXT("DialogueWidget: Dialogue hidden"));
+	HideChoiceButtons();
+	UE_LOG(LogTemp, Verbose, TEXT("DialogueWidget: Dialogue hidden"));
 }
 
 void UDialogueWidget::HandleChoiceButtonClicked(UChoiceButton* ClickedButton, int32 ChoiceIndex)
 {
-	UE_LOG(LogTemp, Warning, TEXT("=== CHOICE BUTTON SELF-IDENTIFIED: Index %d ==="), ChoiceIndex);
+	UE_LOG(LogTemp, Verbose, TEXT("DialogueWidget: Choice button clicked, index %d"), ChoiceIndex);
 
 	if (!bIsDialogueComponentBound || !WeakDialogueComponent.IsValid())
 	{
@@ -204,14 +241,15 @@ void UDialogueWidget::HandleChoiceButtonClicked(UChoiceButton* ClickedButton, in
 		return;
 	}
 
-	// Validate button and index match our array
-	if (!ChoiceButtons.IsValidIndex(ChoiceIndex) || ChoiceButtons[ChoiceIndex] != ClickedButton)
+	// Validate the button is one of the active ones and still carries the index it was bound with
+	const int32 PoolIndex = ChoiceButtons.Find(ClickedButton);
+	if (!ClickedButton || PoolIndex == INDEX_NONE || PoolIndex >= NumActiveChoiceButtons || ClickedButton->GetChoiceIndex() != ChoiceIndex)
 	{
 		UE_LOG(LogTemp, Error, TEXT("DialogueWidget: Button validation failed"));
 		return;
 	}
 
-	UE_LOG(LogTemp, Warning, TEXT("DialogueWidget: Broadcasting validated choice: %d"), ChoiceIndex);
+	UE_LOG(LogTemp, Verbose, TEXT("DialogueWidget: Broadcasting validated choice: %d"), ChoiceIndex);
 	OnChoiceSelected.Broadcast(ChoiceIndex);
 
 }
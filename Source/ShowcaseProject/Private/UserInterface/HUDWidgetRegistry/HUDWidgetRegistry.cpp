@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "UserInterface/HUDWidgetRegistry/HUDWidgetRegistry.h"
+
+#include "Blueprint/UserWidget.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+UHUDWidgetRegistry::UHUDWidgetRegistry()
+{
+	OwningPlayer = nullptr;
+	Entries.SetNum(static_cast<int32>(EHUDWidget::Count));
+}
+
+void UHUDWidgetRegistry::Initialize(APlayerController* InOwningPlayer)
+{
+	OwningPlayer = InOwningPlayer;
+}
+
+void UHUDWidgetRegistry::RegisterWidget(EHUDWidget WidgetId, TSubclassOf<UUserWidget> WidgetClass, int32 ZOrder, float UnloadAfterIdleSeconds)
+{
+	FHUDWidgetEntry& Entry = Entries[static_cast<int32>(WidgetId)];
+	Entry.WidgetClass = WidgetClass;
+	Entry.ZOrder = ZOrder;
+	Entry.UnloadAfterIdleSeconds = UnloadAfterIdleSeconds;
+}
+
+UUserWidget* UHUDWidgetRegistry::FindWidget(EHUDWidget WidgetId) const
+{
+	return Entries[static_cast<int32>(WidgetId)].Widget;
+}
+
+UUserWidget* UHUDWidgetRegistry::GetOrCreateWidget(EHUDWidget WidgetId)
+{
+	FHUDWidgetEntry& Entry = Entries[static_cast<int32>(WidgetId)];
+	if (Entry.Widget || !Entry.WidgetClass || !OwningPlayer)
+	{
+		return Entry.Widget;
+	}
+
+	Entry.Widget = CreateWidget<UUserWidget>(OwningPlayer, Entry.WidgetClass);
+	if (!Entry.Widget)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HUDWidgetRegistry: Failed to create widget %s"), *UEnum::GetValueAsString(WidgetId));
+		return nullptr;
+	}
+
+	Entry.Widget->AddToViewport(Entry.ZOrder);
+	Entry.Widget->SetVisibility(ESlateVisibility::Collapsed);
+	Entry.bIsShown = false;
+	Entry.LastHiddenTime = GetRealTimeSeconds();
+
+	UE_LOG(LogTemp, Log, TEXT("HUDWidgetRegistry: Created widget %s"), *UEnum::GetValueAsString(WidgetId));
+
+	OnWidgetCreated.ExecuteIfBound(WidgetId, Entry.Widget);
+	return Entry.Widget;
+}
+
+void UHUDWidgetRegistry::PrewarmWidget(EHUDWidget WidgetId)
+{
+	GetOrCreateWidget(WidgetId);
+}
+
+void UHUDWidgetRegistry::MarkShown(EHUDWidget WidgetId)
+{
+	Entries[static_cast<int32>(WidgetId)].bIsShown = true;
+}
+
+void UHUDWidgetRegistry::MarkHidden(EHUDWidget WidgetId)
+{
+	FHUDWidgetEntry& Entry = Entries[static_cast<int32>(WidgetId)];
+	Entry.bIsShown = false;
+	Entry.LastHiddenTime = GetRealTimeSeconds();
+}
+
+void UHUDWidgetRegistry::UnloadIdleWidgets()
+{
+	const double Now = GetRealTimeSeconds();
+
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		const FHUDWidgetEntry& Entry = Entries[Index];
+		if (!Entry.Widget || Entry.bIsShown || Entry.UnloadAfterIdleSeconds <= 0.0f)
+		{
+			continue;
+		}
+
+		if (Now - Entry.LastHiddenTime >= Entry.UnloadAfterIdleSeconds)
+		{
+			UnloadWidget(static_cast<EHUDWidget>(Index));
+		}
+	}
+}
+
+void UHUDWidgetRegistry::UnloadWidget(EHUDWidget WidgetId)
+{
+	FHUDWidgetEntry& Entry = Entries[static_cast<int32>(WidgetId)];
+	if (!Entry.Widget) return;
+
+	UE_LOG(LogTemp, Log, TEXT("HUDWidgetRegistry: Unloading idle widget %s"), *UEnum::GetValueAsString(WidgetId));
+
+	// Dropping the reference lets GC reclaim the widget tree and everything it pulled in
+	Entry.Widget->RemoveFromParent();
+	Entry.Widget = nullptr;
+	Entry.bIsShown = false;
+}
+
+double UHUDWidgetRegistry::GetRealTimeSeconds() const
+{
+	const UWorld* World = OwningPlayer ? OwningPlayer->GetWorld() : nullptr;
+	return World ? World->GetRealTimeSeconds() : 0.0;
+}
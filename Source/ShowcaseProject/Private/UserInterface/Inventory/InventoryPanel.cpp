@@ -17,14 +17,32 @@ void UInventoryPanel::NativeOnInitialized()
 	if (PlayerCharacter)
 	{
 		InventoryReference = PlayerCharacter->GetInventory();
-		if (InventoryReference)
-		{
-			InventoryReference->OnInventoryUpdated.AddUObject(this, &UInventoryPanel::RefreshInventory);
-			SetInfoText();
-		}
 	}
 }
 
+void UInventoryPanel::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	// The panel can be created long after the inventory changed, and released again when idle,
+	// so bind while it is in the viewport and catch up on whatever happened in the meantime
+	if (InventoryReference)
+	{
+		InventoryReference->OnInventoryUpdated.AddUObject(this, &UInventoryPanel::RefreshInventory);
+		RefreshInventory();
+	}
+}
+
+void UInventoryPanel::NativeDestruct()
+{
+	if (InventoryReference)
+	{
+		InventoryReference->OnInventoryUpdated.RemoveAll(this);
+	}
+
+	Super::NativeDestruct();
+}
+
 void UInventoryPanel::SetInfoText() const
 {
 	//Setting the text for weight and capacity info
@@ -39,7 +57,7 @@ void UInventoryPanel::RefreshInventory()
 	UE_LOG(LogTemp, Log, TEXT("UInventoryPanel::RefreshInventory: InventoryItemSlotClass is %s."), InventoryItemSlotClass ? TEXT("valid") : TEXT("null"));
 	
 	UE_LOG(LogTemp, Log, TEXT("UInventoryPanel::RefreshInventory: Refreshing inventory panel for player %s."), *GetOwningPlayer()->GetName());
-	if (InventoryReference && InventoryItemSlotClass)
+	if (InventoryReference && InventoryItemSlotClass && InventoryPanel)
 	{
 		UE_LOG(LogTemp, Log, TEXT("UInventoryPanel::RefreshInventory: Refreshing inventory panel."));
 		InventoryPanel->ClearChildren();
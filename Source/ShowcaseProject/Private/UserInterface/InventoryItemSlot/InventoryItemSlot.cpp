@@ -15,7 +15,7 @@ void UInventoryItemSlot::NativeOnInitialized()
 
 	if (InventoryTooltipClass)
 	{
-		UInventoryTooltip* Tooltip = CreateWidget<UInventoryTooltip>(this, InventoryTooltipClass);
+		Tooltip = CreateWidget<UInventoryTooltip>(this, InventoryTooltipClass);
 		Tooltip->InventorySlotBeingHovered = this;
 		SetToolTip(Tooltip);
 	}
@@ -25,6 +25,19 @@ void UInventoryItemSlot::NativeConstruct()
 {
 	Super::NativeConstruct();
 	UE_LOG(LogTemp, Log, TEXT("UInventoryItemSlot::NativeConstruct: Constructing inventory item slot for item %s."), *GetNameSafe(ItemReference));
+	RefreshSlot();
+}
+
+void UInventoryItemSlot::NativeOnListItemObjectSet(UObject* ListItemObject)
+{
+	IUserObjectListEntry::NativeOnListItemObjectSet(ListItemObject);
+
+	ItemReference = Cast<UItemBase>(ListItemObject);
+	RefreshSlot();
+}
+
+void UInventoryItemSlot::RefreshSlot()
+{
 	if (ItemReference)
 	{
 		switch (ItemReference->ItemQuality) {
@@ -49,6 +62,8 @@ void UInventoryItemSlot::NativeConstruct()
 
 		if (ItemReference->ItemNumericData.bIsStackable)
 		{
+			// Recycled slots may have been collapsed by a non-stackable item
+			ItemQuantity->SetVisibility(ESlateVisibility::Visible);
 			ItemQuantity->SetText(FText::AsNumber(ItemReference->Quantity));
 		}
 		else
@@ -56,6 +71,12 @@ void UInventoryItemSlot::NativeConstruct()
 			ItemQuantity->SetVisibility(ESlateVisibility::Collapsed);
 		}
 	}
+
+	// The tooltip was built for whatever item the slot showed before it was recycled
+	if (Tooltip)
+	{
+		Tooltip->RefreshTooltip();
+	}
 }
 
 FReply UInventoryItemSlot::NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "UserInterface/InventoryTilePanel/InventoryTilePanel.h"
+
+#include "Components/TileView.h"
+#include "Components/InventoryComponent/InventoryComponent.h"
+#include "Items/ItemBase.h"
+#include "UserInterface/InventoryItemSlot/InventoryItemSlot.h"
+
+void UInventoryTilePanel::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	if (InventoryTileView)
+	{
+		// Generated entries need to know which panel owns the context menu
+		InventoryTileView->OnEntryWidgetGenerated().AddUObject(this, &UInventoryTilePanel::HandleEntryWidgetGenerated);
+	}
+}
+
+void UInventoryTilePanel::RefreshInventory()
+{
+	if (!InventoryReference || !InventoryTileView) return;
+
+	CloseActiveContextMenu();
+
+	// The tile view only builds widgets for the visible rows and keeps entries for items it already shows
+	InventoryTileView->SetListItems(InventoryReference->GetInventoryContents());
+
+	// Entries that kept their item are not re-initialised by the view, so refresh quantities on the visible ones
+	for (UUserWidget* EntryWidget : InventoryTileView->GetDisplayedEntryWidgets())
+	{
+		if (UInventoryItemSlot* ItemSlot = Cast<UInventoryItemSlot>(EntryWidget))
+		{
+			ItemSlot->RefreshSlot();
+		}
+	}
+
+	SetInfoText();
+}
+
+void UInventoryTilePanel::HandleEntryWidgetGenerated(UUserWidget& EntryWidget)
+{
+	if (UInventoryItemSlot* ItemSlot = Cast<UInventoryItemSlot>(&EntryWidget))
+	{
+		ItemSlot->SetOwningInventoryPanel(this);
+	}
+}
@@ -11,7 +11,14 @@ void UInventoryTooltip::NativeConstruct()
 {
 	Super::NativeConstruct();
 
-	const UItemBase* ItemBeingHovered = InventorySlotBeingHovered->GetItemReference();
+	RefreshTooltip();
+}
+
+void UInventoryTooltip::RefreshTooltip()
+{
+	// Slots are recycled by the tile view, the item can change or be gone between two calls
+	const UItemBase* ItemBeingHovered = InventorySlotBeingHovered ? InventorySlotBeingHovered->GetItemReference() : nullptr;
+	if (!ItemBeingHovered) return;
 
 	switch (ItemBeingHovered->ItemType) {
 	case EItemType::Weapon:
@@ -56,6 +63,7 @@ void UInventoryTooltip::NativeConstruct()
 
 	if (ItemBeingHovered->ItemNumericData.bIsStackable)
 	{
+		MaxStackSize->SetVisibility(ESlateVisibility::Visible);
 		MaxStackSize->SetText(FText::AsNumber(ItemBeingHovered->ItemNumericData.MaxStackSize));
 	}
 	else
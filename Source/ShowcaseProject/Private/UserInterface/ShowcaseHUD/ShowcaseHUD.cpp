@@ -4,7 +4,8 @@
 #include "UserInterface/ShowcaseHUD/ShowcaseHUD.h"
 
 #include "Components/CanvasPanelSlot.h"
-#include "Kismet/GameplayStatics.h"
+#include "Framework/TimeDilation/TimeDilationSubsystem.h"
+#include "Interfaces/DamageableInterface.h"
 #include "Player/ShowcaseProjectCharacter.h"
 #include "UserInterface/MainMenu/MainMenu.h"
 #include "Weapons/WeaponBase.h"
@@ -18,53 +19,96 @@
 
 AShowcaseHUD::AShowcaseHUD()
 {
+	InventoryTimeDilationCurve = nullptr;
 }
 
 void AShowcaseHUD::BeginPlay()
 {
 	Super::BeginPlay();
 
-	if (MainMenuWidgetClass)
+	// Widgets are registered here but only created the first time they are shown
+	WidgetRegistry = NewObject<UHUDWidgetRegistry>(this);
+	WidgetRegistry->Initialize(GetOwningPlayerController());
+	WidgetRegistry->RegisterWidget(EHUDWidget::MainMenu, MainMenuWidgetClass, 0, MenuUnloadDelay);
+	WidgetRegistry->RegisterWidget(EHUDWidget::WeaponHUD, WeaponHUDClass, 1);
+	WidgetRegistry->RegisterWidget(EHUDWidget::InventoryMenu, InventoryMenuClass, 2, MenuUnloadDelay);
+	WidgetRegistry->RegisterWidget(EHUDWidget::Interaction, InteractionWidgetClass, 3);
+	WidgetRegistry->RegisterWidget(EHUDWidget::Dialogue, DialogueWidgetClass, 4, MenuUnloadDelay);
+	WidgetRegistry->OnWidgetCreated.BindUObject(this, &AShowcaseHUD::OnWidgetCreated);
+
+	if (bPrewarmOnBeginPlay)
 	{
-		MainMenuWidget = CreateWidget<UMainMenu>(GetWorld(), MainMenuWidgetClass);
-		MainMenuWidget->AddToViewport(0);
-		MainMenuWidget->SetVisibility(ESlateVisibility::Collapsed);
+		PrewarmWidgets();
 	}
-	if (WeaponHUDClass)
+
+	if (MenuUnloadDelay > 0.0f)
+	{
+		WidgetUnloadTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &AShowcaseHUD::UnloadIdleWidgets), WidgetUnloadCheckInterval);
+	}
+}
+
+void AShowcaseHUD::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(WidgetUnloadTickerHandle);
+	WidgetUnloadTickerHandle.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AShowcaseHUD::PrewarmWidgets()
+{
+	if (!WidgetRegistry) return;
+
+	for (const EHUDWidget WidgetId : PrewarmedWidgets)
+	{
+		WidgetRegistry->PrewarmWidget(WidgetId);
+	}
+}
+
+void AShowcaseHUD::OnWidgetCreated(EHUDWidget WidgetId, UUserWidget* Widget)
+{
+	if (WidgetId == EHUDWidget::WeaponHUD)
 	{
-		WeaponHUDWidget = CreateWidget<UWeaponHUD>(GetWorld(), WeaponHUDClass);
-		WeaponHUDWidget->AddToViewport(1);
-		WeaponHUDWidget->SetVisibility(ESlateVisibility::Collapsed);
 		// Set position to lower right corner
-		if (UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>(WeaponHUDWidget->Slot))
+		if (UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>(Widget->Slot))
 		{
 			CanvasSlot->SetAnchors(FAnchors(1.0f, 1.0f, 1.0f, 1.0f));
 			CanvasSlot->SetPosition(FVector2D(-250.0f, -120.0f)); 
 			CanvasSlot->SetSize(FVector2D(200.0f, 100.0f));
 		}
 	}
-	if (InventoryMenuClass)
-	{
-		InventoryMenuWidget = CreateWidget<UInventoryMenu>(GetWorld(), InventoryMenuClass);
-		InventoryMenuWidget->AddToViewport(2);
-		InventoryMenuWidget->SetVisibility(ESlateVisibility::Collapsed);
-	}
-	if (InteractionWidgetClass)
+}
+
+bool AShowcaseHUD::UnloadIdleWidgets(float DeltaTime)
+{
+	if (WidgetRegistry)
 	{
-		InteractionWidget = CreateWidget<UInteractionWidget>(GetWorld(), InteractionWidgetClass);
-		InteractionWidget->AddToViewport(3);
-		InteractionWidget->SetVisibility(ESlateVisibility::Collapsed);
+		WidgetRegistry->UnloadIdleWidgets();
 	}
+	return true;
+}
+
+UWeaponHUD* AShowcaseHUD::GetWeaponHUD()
+{
+	return WidgetRegistry ? WidgetRegistry->GetOrCreateWidget<UWeaponHUD>(EHUDWidget::WeaponHUD) : nullptr;
 }
 
 void AShowcaseHUD::ToggleMainMenu()
 {
+	if (!WidgetRegistry) return;
+
+	UMainMenu* MainMenuWidget = bIsMainMenuVisible
+		? WidgetRegistry->FindWidget<UMainMenu>(EHUDWidget::MainMenu)
+		: WidgetRegistry->GetOrCreateWidget<UMainMenu>(EHUDWidget::MainMenu);
+
 	if (MainMenuWidget)
 	{
 		bIsMainMenuVisible = !bIsMainMenuVisible;
 		if (bIsMainMenuVisible)
 		{
 			MainMenuWidget->SetVisibility(ESlateVisibility::Visible);
+			WidgetRegistry->MarkShown(EHUDWidget::MainMenu);
 
 			const FInputModeUIOnly InputMode;
 			GetOwningPlayerController()->SetInputMode(InputMode);
@@ -73,6 +117,8 @@ void AShowcaseHUD::ToggleMainMenu()
 		else
 		{
 			MainMenuWidget->SetVisibility(ESlateVisibility::Collapsed);
+			WidgetRegistry->MarkHidden(EHUDWidget::MainMenu);
+
 			const FInputModeGameOnly InputMode;
 			GetOwningPlayerController()->SetInputMode(InputMode);
 			GetOwningPlayerController()->SetShowMouseCursor(false);
@@ -82,6 +128,12 @@ void AShowcaseHUD::ToggleMainMenu()
 
 void AShowcaseHUD::ToggleInventoryMenu()
 {
+	if (!WidgetRegistry) return;
+
+	UInventoryMenu* InventoryMenuWidget = bIsInventoryMenuVisible
+		? WidgetRegistry->FindWidget<UInventoryMenu>(EHUDWidget::InventoryMenu)
+		: WidgetRegistry->GetOrCreateWidget<UInventoryMenu>(EHUDWidget::InventoryMenu);
+
 	if (InventoryMenuWidget)
 	{
 		bIsInventoryMenuVisible = !bIsInventoryMenuVisible;
@@ -89,64 +141,57 @@ void AShowcaseHUD::ToggleInventoryMenu()
 		if (bIsInventoryMenuVisible)
 		{
 			InventoryMenuWidget->SetVisibility(ESlateVisibility::Visible);
+			WidgetRegistry->MarkShown(EHUDWidget::InventoryMenu);
 
 			const FInputModeGameAndUI InputMode;
 			GetOwningPlayerController()->SetInputMode(InputMode);
 			GetOwningPlayerController()->SetShowMouseCursor(true);
 
-			// Slowly lerp to 0.1
-			TargetTimeDilation = 0.1f;
+			// Blend into slow-mo over real time
+			if (UTimeDilationSubsystem* TimeDilation = GetWorld()->GetSubsystem<UTimeDilationSubsystem>())
+			{
+				TimeDilation->PushTimeDilation(TEXT("InventoryMenu"), InventoryTimeDilation, InventoryTimeDilationPriority, InventoryTimeDilationBlendTime, InventoryTimeDilationCurve);
+			}
 		}
 		else
 		{
 			InventoryMenuWidget->SetVisibility(ESlateVisibility::Collapsed);
+			WidgetRegistry->MarkHidden(EHUDWidget::InventoryMenu);
 
 			const FInputModeGameOnly InputMode;
 			GetOwningPlayerController()->SetInputMode(InputMode);
 			GetOwningPlayerController()->SetShowMouseCursor(false);
 
-			// Instantly return to normal speed
-			TargetTimeDilation = 1.0f;
-			CurrentTimeDilation = 1.0f;
+			// Instantly return to normal speed (or whichever request is still active)
+			if (UTimeDilationSubsystem* TimeDilation = GetWorld()->GetSubsystem<UTimeDilationSubsystem>())
+			{
+				TimeDilation->PopTimeDilation(TEXT("InventoryMenu"));
+			}
 
 			InventoryMenuWidget->WBP_InventoryPanel->CloseActiveContextMenu();
 		}
-		// Start updating time dilation each tick
-		GetWorld()->GetTimerManager().SetTimer(TimeDilationTimerHandle, this, &AShowcaseHUD::UpdateTimeDilation, 0.01f, true);
-	}
-}
-
-void AShowcaseHUD::UpdateTimeDilation()
-{
-	CurrentTimeDilation = FMath::FInterpTo(CurrentTimeDilation, TargetTimeDilation, GetWorld()->GetDeltaSeconds(), TimeDilationInterpSpeed);
-	UGameplayStatics::SetGlobalTimeDilation(GetWorld(), CurrentTimeDilation);
-
-	if (FMath::IsNearlyEqual(CurrentTimeDilation, TargetTimeDilation, 0.01f))
-	{
-		UGameplayStatics::SetGlobalTimeDilation(GetWorld(), TargetTimeDilation);
-		GetWorld()->GetTimerManager().ClearTimer(TimeDilationTimerHandle);
 	}
 }
 
-void AShowcaseHUD::ShowInteractionWidget() const
+void AShowcaseHUD::ShowInteractionWidget()
 {
-	if (InteractionWidget)
+	if (UInteractionWidget* InteractionWidget = WidgetRegistry ? WidgetRegistry->GetOrCreateWidget<UInteractionWidget>(EHUDWidget::Interaction) : nullptr)
 	{
 		InteractionWidget->SetVisibility(ESlateVisibility::Visible);
 	}
 }
 
-void AShowcaseHUD::HideInteractionWidget() const
+void AShowcaseHUD::HideInteractionWidget()
 {
-	if (InteractionWidget)
+	if (UInteractionWidget* InteractionWidget = WidgetRegistry ? WidgetRegistry->FindWidget<UInteractionWidget>(EHUDWidget::Interaction) : nullptr)
 	{
 		InteractionWidget->SetVisibility(ESlateVisibility::Collapsed);
 	}
 }
 
-void AShowcaseHUD::UpdateInteractionWidget(const FInteractableData* InteractableData) const
+void AShowcaseHUD::UpdateInteractionWidget(const FInteractableData* InteractableData)
 {
-	if (InteractionWidget)
+	if (UInteractionWidget* InteractionWidget = WidgetRegistry ? WidgetRegistry->GetOrCreateWidget<UInteractionWidget>(EHUDWidget::Interaction) : nullptr)
 	{
 		if (InteractionWidget->GetVisibility() == ESlateVisibility::Collapsed)
 		{
@@ -159,11 +204,13 @@ void AShowcaseHUD::UpdateInteractionWidget(const FInteractableData* Interactable
 void AShowcaseHUD::UpdateWeaponDisplay(AWeaponBase* EquippedWeapon)
 {
 	UE_LOG(LogTemp, Log, TEXT("Updating weapon display for: %s"), *GetNameSafe(EquippedWeapon));
-	if (!WeaponHUDWidget) return;
+	if (!WidgetRegistry) return;
 
 	if (EquippedWeapon && EquippedWeapon->GetWeaponItemData())
 	{
-        
+		UWeaponHUD* WeaponHUDWidget = GetWeaponHUD();
+		if (!WeaponHUDWidget) return;
+
 		WeaponHUDWidget->UpdateWeaponInfo(EquippedWeapon->GetWeaponItemData()->ItemAssetData.Icon,
 			EquippedWeapon->GetCurrentAmmoInMagazine(),
 			EquippedWeapon->GetCurrentReserveAmmo()
@@ -185,7 +232,7 @@ void AShowcaseHUD::UpdateWeaponDisplay(AWeaponBase* EquippedWeapon)
 			}
 		}
 	}
-	else
+	else if (UWeaponHUD* WeaponHUDWidget = WidgetRegistry->FindWidget<UWeaponHUD>(EHUDWidget::WeaponHUD))
 	{
 		WeaponHUDWidget->HideCrosshair();
 		WeaponHUDWidget->ForceHide();
@@ -194,7 +241,7 @@ void AShowcaseHUD::UpdateWeaponDisplay(AWeaponBase* EquippedWeapon)
 
 void AShowcaseHUD::OnWeaponAimStart()
 {
-	if (WeaponHUDWidget)
+	if (UWeaponHUD* WeaponHUDWidget = GetWeaponHUD())
 	{
 		WeaponHUDWidget->StartAiming();
 	}
@@ -202,15 +249,16 @@ void AShowcaseHUD::OnWeaponAimStart()
 
 void AShowcaseHUD::OnWeaponAimStop()
 {
-	if (WeaponHUDWidget)
+	if (UWeaponHUD* WeaponHUDWidget = WidgetRegistry ? WidgetRegistry->FindWidget<UWeaponHUD>(EHUDWidget::WeaponHUD) : nullptr)
 	{
 		WeaponHUDWidget->StopAiming();
+		WeaponHUDWidget->HideCrosshair();
 	}
 }
 
 void AShowcaseHUD::OnWeaponFired()
 {
-	if (WeaponHUDWidget)
+	if (UWeaponHUD* WeaponHUDWidget = GetWeaponHUD())
 	{
 		WeaponHUDWidget->OnWeaponFired();
 	}
@@ -218,56 +266,52 @@ void AShowcaseHUD::OnWeaponFired()
 
 void AShowcaseHUD::OnWeaponStoppedFiring()
 {
-	if (WeaponHUDWidget)
+	if (UWeaponHUD* WeaponHUDWidget = WidgetRegistry ? WidgetRegistry->FindWidget<UWeaponHUD>(EHUDWidget::WeaponHUD) : nullptr)
 	{
 		WeaponHUDWidget->OnWeaponStoppedFiring();
 	}
 }
 
-// Fix your ShowDialogue implementation - you called the wrong method in DialogueComponent
-void AShowcaseHUD::ShowDialogue(const FDialogueNode& DialogueNode, UDialogueComponent* DialogueComponent)
+void AShowcaseHUD::OnAimTargetChanged(AActor* NewTarget)
 {
-	if (!DialogueWidget && DialogueWidgetClass)
+	if (UWeaponHUD* WeaponHUDWidget = WidgetRegistry ? WidgetRegistry->FindWidget<UWeaponHUD>(EHUDWidget::WeaponHUD) : nullptr)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("ShowcaseHUD: Creating dialogue widget"));
-		DialogueWidget = CreateWidget<UDialogueWidget>(GetWorld(), DialogueWidgetClass);
-		if (DialogueWidget)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("ShowcaseHUD: Dialogue widget created successfully"));
-			DialogueWidget->AddToViewport(4);
-		}
-		else
-		{
-			UE_LOG(LogTemp, Error, TEXT("ShowcaseHUD: Failed to create dialogue widget"));
-			return;
-		}
+		const bool bIsDamageable = NewTarget && NewTarget->GetClass()->ImplementsInterface(UDamageableInterface::StaticClass());
+		WeaponHUDWidget->SetCrosshairOverTarget(bIsDamageable);
 	}
+}
+
+void AShowcaseHUD::ShowDialogue(const FDialogueNode& DialogueNode, UDialogueComponent* DialogueComponent)
+{
+	UDialogueWidget* DialogueWidget = WidgetRegistry ? WidgetRegistry->GetOrCreateWidget<UDialogueWidget>(EHUDWidget::Dialogue) : nullptr;
 
 	if (DialogueWidget)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("ShowcaseHUD: Setting dialogue component and displaying node"));
+		UE_LOG(LogTemp, VeryVerbose, TEXT("ShowcaseHUD: Setting dialogue component and displaying node"));
 		DialogueWidget->SetDialogueComponent(DialogueComponent);
 		DialogueWidget->DisplayDialogueNode(DialogueNode);
+		WidgetRegistry->MarkShown(EHUDWidget::Dialogue);
 
 		if (APlayerController* PC = GetOwningPlayerController())
 		{
 			const FInputModeGameAndUI InputMode;
 			PC->SetInputMode(InputMode);
 			PC->SetShowMouseCursor(true);
-			UE_LOG(LogTemp, Warning, TEXT("ShowcaseHUD: Input mode set to GameAndUI"));
+			UE_LOG(LogTemp, VeryVerbose, TEXT("ShowcaseHUD: Input mode set to GameAndUI"));
 		}
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("ShowcaseHUD: DialogueWidget is null"));
+		UE_LOG(LogTemp, Error, TEXT("ShowcaseHUD: Failed to create dialogue widget"));
 	}
 }
 
 void AShowcaseHUD::HideDialogue()
 {
-	if (DialogueWidget)
+	if (UDialogueWidget* DialogueWidget = WidgetRegistry ? WidgetRegistry->FindWidget<UDialogueWidget>(EHUDWidget::Dialogue) : nullptr)
 	{
 		DialogueWidget->HideDialogueNode();
+		WidgetRegistry->MarkHidden(EHUDWidget::Dialogue);
 
 		// Restore game-only input mode
 		if (APlayerController* PC = GetOwningPlayerController())
@@ -277,4 +321,4 @@ void AShowcaseHUD::HideDialogue()
 			PC->SetShowMouseCursor(false);
 		}
 	}
-}
\ No newline at end of file
+}
@@ -6,6 +6,25 @@
 #include "Components/Image.h"
 #include "Animation/WidgetAnimation.h"
 #include "Components/TextBlock.h"
+#include "Components/InvalidationBox.h"
+
+void UWeaponHUD::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	BuildAmmoTextCache();
+
+	// The separator never changes, set it once
+	if (AmmoSeparatorText)
+	{
+		AmmoSeparatorText->SetText(FText::FromString(TEXT("/")));
+	}
+
+	if (WeaponHUDInvalidationBox)
+	{
+		WeaponHUDInvalidationBox->SetCanCache(true);
+	}
+}
 
 void UWeaponHUD::NativeConstruct()
 {
@@ -19,24 +38,45 @@ void UWeaponHUD::NativeConstruct()
 
 void UWeaponHUD::UpdateWeaponInfo(UTexture2D* WeaponIcon, int32 CurrentAmmo, int32 TotalAmmo)
 {
-	if (WeaponIconImage && WeaponIcon)
+	// Only touch the widgets whose value actually changed, every SetX call invalidates the widget
+	if (WeaponIconImage && WeaponIcon && DisplayedWeaponIcon.Get() != WeaponIcon)
 	{
 		WeaponIconImage->SetBrushFromTexture(WeaponIcon);
+		DisplayedWeaponIcon = WeaponIcon;
 	}
-	if (CurrentAmmoText)
+	if (CurrentAmmoText && DisplayedCurrentAmmo != CurrentAmmo)
 	{
-		CurrentAmmoText->SetText(FText::AsNumber(CurrentAmmo));
+		CurrentAmmoText->SetText(GetAmmoText(CurrentAmmo));
+		DisplayedCurrentAmmo = CurrentAmmo;
 	}
-	if (TotalAmmoText)
+	if (TotalAmmoText && DisplayedTotalAmmo != TotalAmmo)
 	{
-		TotalAmmoText->SetText(FText::AsNumber(TotalAmmo));
+		TotalAmmoText->SetText(GetAmmoText(TotalAmmo));
+		DisplayedTotalAmmo = TotalAmmo;
 	}
-	if (AmmoSeparatorText)
+}
+
+void UWeaponHUD::BuildAmmoTextCache()
+{
+	const int32 CacheSize = FMath::Max(MaxCachedAmmoValue, 0) + 1;
+	AmmoTextCache.Reset(CacheSize);
+	for (int32 Value = 0; Value < CacheSize; ++Value)
 	{
-		AmmoSeparatorText->SetText(FText::FromString(TEXT("/")));
+		AmmoTextCache.Add(FText::AsNumber(Value));
 	}
 }
 
+const FText& UWeaponHUD::GetAmmoText(int32 AmmoValue)
+{
+	if (AmmoTextCache.IsValidIndex(AmmoValue))
+	{
+		return AmmoTextCache[AmmoValue];
+	}
+	// Out of the cached range, format on demand
+	AmmoTextFallback = FText::AsNumber(AmmoValue);
+	return AmmoTextFallback;
+}
+
 void UWeaponHUD::StartAiming()
 {
 	UE_LOG(LogTemp, Log, TEXT("WeaponHUD: Start Aiming"));
@@ -125,32 +165,56 @@ void UWeaponHUD::ForceHide()
 
 void UWeaponHUD::UpdateCrosshair(UTexture2D* CrosshairTexture, FLinearColor CrosshairColor, float CrosshairSize)
 {
-	if (CrosshairImage && CrosshairTexture)
+	if (!CrosshairImage || !CrosshairTexture) return;
+
+	if (DisplayedCrosshairTexture.Get() != CrosshairTexture)
 	{
 		CrosshairImage->SetBrushFromTexture(CrosshairTexture);
-		CrosshairImage->SetColorAndOpacity(CrosshairColor);
-        
-		// Scale the crosshair
+		DisplayedCrosshairTexture = CrosshairTexture;
+	}
+
+	// A negative size means nothing has been pushed to the image yet
+	if (DisplayedCrosshairSize < 0.0f || !WeaponCrosshairColor.Equals(CrosshairColor))
+	{
+		WeaponCrosshairColor = CrosshairColor;
+		CrosshairImage->SetColorAndOpacity(bCrosshairOverTarget ? TargetCrosshairColor : CrosshairColor);
+	}
+
+	// Scale the crosshair
+	if (!FMath::IsNearlyEqual(DisplayedCrosshairSize, CrosshairSize))
+	{
 		CrosshairImage->SetRenderScale(FVector2D(CrosshairSize, CrosshairSize));
+		DisplayedCrosshairSize = CrosshairSize;
 	}
 }
 
 void UWeaponHUD::ShowCrosshair()
 {
-	if (CrosshairImage)
+	if (CrosshairImage && CrosshairImage->GetVisibility() != ESlateVisibility::HitTestInvisible)
 	{
-		CrosshairImage->SetVisibility(ESlateVisibility::Visible);
+		CrosshairImage->SetVisibility(ESlateVisibility::HitTestInvisible);
 	}
 }
 
 void UWeaponHUD::HideCrosshair()
 {
-	if (CrosshairImage)
+	if (CrosshairImage && CrosshairImage->GetVisibility() != ESlateVisibility::Collapsed)
 	{
 		CrosshairImage->SetVisibility(ESlateVisibility::Collapsed);
 	}
 }
 
+void UWeaponHUD::SetCrosshairOverTarget(bool bOverTarget)
+{
+	if (bCrosshairOverTarget == bOverTarget) return;
+	bCrosshairOverTarget = bOverTarget;
+
+	if (CrosshairImage)
+	{
+		CrosshairImage->SetColorAndOpacity(bCrosshairOverTarget ? TargetCrosshairColor : WeaponCrosshairColor);
+	}
+}
+
 void UWeaponHUD::ShowWithAnimation()
 {
 	UE_LOG(LogTemp, Log, TEXT("WeaponHUD: Showing with animation"));
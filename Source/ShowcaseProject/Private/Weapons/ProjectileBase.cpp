@@ -4,6 +4,13 @@
 #include "Components/SphereComponent.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Interfaces/DamageableInterface.h"
+#include "NPC/Perception/NPCNoiseSubsystem.h"
+
+namespace
+{
+	constexpr float ImpactLoudness = 0.75f;
+	const FName ImpactNoiseTag(TEXT("Impact"));
+}
 
 // Sets default values
 AProjectileBase::AProjectileBase()
@@ -193,6 +200,12 @@ void AProjectileBase::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UP
 		GetWorldTimerManager().ClearTimer(LifetimeTimerHandle);
 	}
 
+	// Shotgun pellets and automatic fire land close together, they merge into one impact noise
+	if (UNPCNoiseSubsystem* Noise = GetWorld()->GetSubsystem<UNPCNoiseSubsystem>())
+	{
+		Noise->ReportNoise(Hit.Location, ImpactLoudness, GetOwner(), ImpactNoiseTag);
+	}
+
 	// Check if target implements damage interface
 	if (OtherActor->GetClass()->ImplementsInterface(UDamageableInterface::StaticClass()))
 	{
@@ -3,11 +3,23 @@
 
 #include "Weapons/WeaponBase.h"
 #include "Player/ShowcaseProjectCharacter.h"
+#include "Components/AimComponent/AimComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "NiagaraFunctionLibrary.h"
 #include "Components/InventoryComponent/InventoryComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "UserInterface/ShowcaseHUD/ShowcaseHUD.h"
+#include "NPC/Perception/NPCNoiseSubsystem.h"
+
+namespace
+{
+	// Multiples of an NPC's hearing range
+	constexpr float GunshotLoudness = 2.0f;
+	constexpr float ReloadLoudness = 0.3f;
+
+	const FName GunshotNoiseTag(TEXT("Gunshot"));
+	const FName ReloadNoiseTag(TEXT("Reload"));
+}
 
 // Sets default values
 AWeaponBase::AWeaponBase()
@@ -330,27 +342,22 @@ void AWeaponBase::FireBullet()
         SpawnRotation = GetActorRotation();
     }
 	
-	FVector2D ViewportSize;
-	GetWorld()->GetGameViewport()->GetViewportSize(ViewportSize);
-	FVector2D CrosshairScreenPosition = ViewportSize * 0.5f;
-
-	// Convert crosshair screen position to world space
-	FVector CrosshairWorldLocation;
-	FVector CrosshairWorldDirection;
-	if (APlayerController* PC = GetWorld()->GetFirstPlayerController())
-	{
-		PC->DeprojectScreenPositionToWorld(
-			CrosshairScreenPosition.X, 
-			CrosshairScreenPosition.Y, 
-			CrosshairWorldLocation, 
-			CrosshairWorldDirection
-		);
+	// Aim at the point the shared crosshair ray resolved to this frame
+	FVector TargetLocation = SpawnLocation + SpawnRotation.Vector() * 10000.0f;
+	if (OwningCharacter && OwningCharacter->GetAimComponent())
+	{
+		TargetLocation = OwningCharacter->GetAimComponent()->GetAimPoint();
 	}
 
 	// Calculate bullet direction from spawn point to crosshair world position
-	FVector TargetLocation = CrosshairWorldLocation + (CrosshairWorldDirection * 10000.0f);
 	FVector BulletDirection = (TargetLocation - SpawnLocation).GetSafeNormal();
 	SpawnRotation = BulletDirection.Rotation();
+
+	// One noise per shot, merged with the previous shots by the noise subsystem
+	if (UNPCNoiseSubsystem* Noise = GetWorld()->GetSubsystem<UNPCNoiseSubsystem>())
+	{
+		Noise->ReportNoise(SpawnLocation, GunshotLoudness, GetOwner(), GunshotNoiseTag);
+	}
 	
     // Check if this is a shotgun (uses pellets)
     if (WeaponItemData->WeaponCategory == EWeaponCategory::Shotgun && WeaponItemData->WeaponData.ShotgunPelletCount > 1)
@@ -565,6 +572,11 @@ void AWeaponBase::Reload()
 	UE_LOG(LogTemp, Log, TEXT("Reloading weapon: %s"), *WeaponItemData->ItemTextData.Name.ToString());
 	bIsReloading = true;
 
+	if (UNPCNoiseSubsystem* Noise = GetWorld()->GetSubsystem<UNPCNoiseSubsystem>())
+	{
+		Noise->ReportNoise(GetActorLocation(), ReloadLoudness, GetOwner(), ReloadNoiseTag);
+	}
+
 	// Play reload animation montage if available
 	if (WeaponItemData && WeaponItemData->WeaponData.ReloadMontage)
 	{
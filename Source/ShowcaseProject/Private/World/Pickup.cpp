@@ -33,19 +33,7 @@ void APickup::InitializePickup(const TSubclassOf<UItemBase> BaseClass, const int
 	{
 		const FItemData* ItemData = ItemDataTable->FindRow<FItemData>(DesiredItemID, DesiredItemID.ToString());
 
-		ItemReference = NewObject<UItemBase>(this, BaseClass);
-
-		ItemReference->ItemID = ItemData->ItemID;
-		ItemReference->WeaponCategory = ItemData->WeaponCategory;
-		ItemReference->ItemType = ItemData->ItemType;
-		ItemReference->ItemQuality = ItemData->ItemQuality;
-		ItemReference->ItemNumericData = ItemData->ItemNumericData;
-		ItemReference->ItemTextData = ItemData->ItemTextData;
-		ItemReference->ItemAssetData = ItemData->ItemAssetData;
-		ItemReference->WeaponData = ItemData->WeaponData;
-		ItemReference->AmmoData = ItemData->AmmoData;
-		ItemReference->ItemStatistics = ItemData->ItemStatistics;
-		
+		ItemReference = UItemBase::CreateFromItemData(this, BaseClass, *ItemData);
 
 		InQuantity <= 0 ? ItemReference->SetQuantity(1) : ItemReference->SetQuantity(InQuantity);
 
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "WorldCollision.h"
+#include "AimComponent.generated.h"
+
+class APlayerController;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnAimTargetChanged, AActor* /*NewTarget*/);
+
+USTRUCT(BlueprintType)
+struct FAimState
+{
+	GENERATED_USTRUCT_BODY()
+
+	// Camera ray through the centre of the viewport
+	UPROPERTY(BlueprintReadOnly, Category = "Aim")
+	FVector RayOrigin = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Aim")
+	FVector RayDirection = FVector::ForwardVector;
+
+	// Where the crosshair resolves to in the world (trace hit or the end of the ray)
+	UPROPERTY(BlueprintReadOnly, Category = "Aim")
+	FVector AimPoint = FVector::ZeroVector;
+
+	// Actor under the crosshair from the most recent completed trace
+	UPROPERTY(BlueprintReadOnly, Category = "Aim")
+	TWeakObjectPtr<AActor> AimTarget;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Aim")
+	bool bHasBlockingHit = false;
+
+	// Frame the ray was built on, used to build it at most once per frame
+	uint64 FrameNumber = 0;
+};
+
+/**
+ * Builds the crosshair ray and aim target once per frame for the local player.
+ * Character rotation, weapon firing and the weapon HUD all read the cached result instead of
+ * deprojecting the viewport themselves. The world trace is issued asynchronously and its
+ * result is consumed on the following frame.
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class SHOWCASEPROJECT_API UAimComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this component's properties
+	UAimComponent();
+
+	// Called every frame
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// Returns this frame's aim state, building the camera ray if nothing has requested it yet this frame
+	const FAimState& GetAimState();
+
+	UFUNCTION(BlueprintCallable, Category = "Aim")
+	FVector GetAimPoint() { return GetAimState().AimPoint; }
+
+	UFUNCTION(BlueprintCallable, Category = "Aim")
+	FVector GetAimDirection() { return GetAimState().RayDirection; }
+
+	UFUNCTION(BlueprintPure, Category = "Aim")
+	FORCEINLINE AActor* GetAimTarget() const { return AimState.AimTarget.Get(); }
+
+	// Broadcast when the actor under the crosshair changes
+	FOnAimTargetChanged OnAimTargetChanged;
+
+protected:
+	// Called when the game starts
+	virtual void BeginPlay() override;
+
+	// How far the crosshair ray reaches when nothing is hit
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Aim")
+	float MaxAimDistance = 10000.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Aim")
+	TEnumAsByte<ECollisionChannel> AimTraceChannel = ECC_Visibility;
+
+private:
+	FAimState AimState;
+
+	// Distance along the ray of the last trace hit, re-applied to the current ray each frame
+	float LastHitDistance = 0.0f;
+
+	FTraceHandle PendingTraceHandle;
+
+	FTraceDelegate AimTraceDelegate;
+
+	APlayerController* GetLocalPlayerController() const;
+	void UpdateAimRay();
+	void RequestAimTrace();
+	void OnAimTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+};
@@ -5,11 +5,14 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Data/ST_DialogueStructs.h"
+#include "Dialogue/Graph/DialogueGraph.h"
 #include "DialogueComponent.generated.h"
 
 
 struct FGameplayTag;
 class ANPC_BaseCharacter;
+class UDialogueFactSubsystem;
+class UAudioComponent;
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class SHOWCASEPROJECT_API UDialogueComponent : public UActorComponent
@@ -30,8 +33,9 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Dialogue")
 	FGameplayTag CurrentNodeTag;
 
+	// Index of the current node in DialogueGraph, INDEX_NONE outside of dialogue
 	UPROPERTY(BlueprintReadOnly, Category = "Dialogue")
-	FDialogueNode CurrentNode;
+	int32 CurrentNodeIndex;
 
 	// Dialogue Events
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnDialogueStart, AActor*, DialoguePartner, FGameplayTag, StartingNode);
@@ -63,17 +67,38 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Dialogue")
 	void AdvanceToNode(FGameplayTag NodeTag);
 
+	void AdvanceToNodeIndex(int32 NodeIndex);
+
+	// Builds FDialogueChoice copies for Blueprint, native code should read the graph directly
 	UFUNCTION(BlueprintPure, Category = "Dialogue")
 	TArray<FDialogueChoice> GetCurrentChoices();
 
+	// Presentation data of the current node with Choices holding the ones whose conditions passed.
+	// Builds copies for Blueprint, advancing never calls it
 	UFUNCTION(BlueprintPure, Category = "Dialogue")
 	FDialogueNode GetCurrentDialogueNode();
 
+	FORCEINLINE const UDialogueGraph* GetDialogueGraph() const { return DialogueGraph; }
+
+	// Choices of the current node whose conditions passed on entry, as indices into the node's choices
+	FORCEINLINE const FDialogueChoiceSet& GetValidChoices() const { return CurrentChoiceSet; }
+
 	UFUNCTION(BlueprintCallable, Category = "Dialogue")
 	bool EvaluateCondition(const FDialogueCondition& Condition);
 
 	UFUNCTION(BlueprintCallable, Category = "Dialogue")
 	void ExecuteAction(const FDialogueAction& Action);
+
+	// State part of advancing: entry conditions, exit/entry actions and choice evaluation, without UI, audio or timers.
+	// Returns false when the node does not exist or its entry conditions fail
+	bool EnterNode(int32 NodeIndex);
+
+	// Puts the component in dialogue on a graph without an owning NPC, for offline traversal (see UDialogueGraphCommandlet)
+	void InitializeHeadless(UDialogueGraph* InDialogueGraph);
+
+	// How many choices ahead voice clips are loaded before they are needed
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue | Voice", meta = (ClampMin = "0", ClampMax = "4"))
+	int32 VoicePrefetchDepth = 2;
 	
 protected:
 	// Called when the game starts
@@ -82,10 +107,26 @@ private:
 	ANPC_BaseCharacter* OwnerNPC;
 	FTimerHandle AutoAdvanceTimer;
 
+	// Compiled graph shared with every NPC using the same dialogue table
+	UPROPERTY()
+	UDialogueGraph* DialogueGraph;
+
+	FDialogueChoiceSet CurrentChoiceSet;
+
+	UPROPERTY()
+	UAudioComponent* VoiceAudioComponent;
+
 	UFUNCTION()
 	void HandleAutoAdvance();
 
 	void ProcessEntryActions();
 	void ProcessExitActions();
-	FDialogueNode* GetDialogueNodeByTag(FGameplayTag NodeTag);
+	void ApplyStateActions() const;
+	bool ResolveDialogueGraph();
+	FDialogueConditionContext BuildConditionContext() const;
+	UDialogueFactSubsystem* GetFactSubsystem() const;
+
+	void PlayNodeVoiceClip(int32 NodeIndex);
+	void StopVoiceClip();
+	FDialogueChoiceSet EvaluateChoices(int32 NodeIndex);
 };
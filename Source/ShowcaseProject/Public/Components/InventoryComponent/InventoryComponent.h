@@ -98,6 +98,10 @@ public:
 	UFUNCTION(Category="Inventory")
 	void SplitExistingStack(UItemBase* ItemToSplit, const int32 AmountToSplit);
 
+	// Groups several changes into one transaction, OnInventoryUpdated fires once when the outermost batch ends
+	void BeginUpdateBatch();
+	void EndUpdateBatch();
+
 	// Getters
 	UFUNCTION(Category="Inventory")
 	FORCEINLINE float GetInventoryTotalWeight() const { return InventoryTotalWeight; };
@@ -140,6 +144,10 @@ protected:
 	int32 CalculateNumberForFullStack(UItemBase* StackableItem, int32 InitialRequestedAddAmount) const;
 
 	void AddNewItemToInventory(UItemBase* NewItem, int32 AmountToAdd);
+	void BroadcastInventoryUpdated();
+
+	int32 UpdateBatchDepth = 0;
+	bool bHasPendingUpdate = false;
 };
 
 
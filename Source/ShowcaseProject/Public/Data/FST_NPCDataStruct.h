@@ -7,6 +7,7 @@
 
 class UTexture2D;
 class USkeletalMesh;
+class UStaticMesh;
 class UNPC_AnimInstance;
 class USoundBase;
 
@@ -64,6 +65,9 @@ struct FST_NPCDataStruct : public FTableRowBase
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
     float TakeCoverHealthThreshold; // Health percentage to take cover
 
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+    TMap<FName, float> BoneDamageMultipliers; // Also matched as part of a bone name, e.g. "spine" hits spine_01
+
     // Behavioral Flags
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behavior")
     bool bCanSpeak;
@@ -94,6 +98,10 @@ struct FST_NPCDataStruct : public FTableRowBase
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Presentation")
     TArray<USoundBase*> VoiceLines;
 
+    // Vertex-animated static mesh drawn for this NPC while it is a distant crowd proxy, none keeps it a full actor
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Presentation")
+    TSoftObjectPtr<UStaticMesh> CrowdProxyMesh;
+
     FST_NPCDataStruct()
     {
         NPCName = TEXT("Generic NPC");
@@ -109,6 +117,14 @@ struct FST_NPCDataStruct : public FTableRowBase
         WeaponDrawTolerance = 0.5f;
         FleeHealthThreshold = 0.3f;
         TakeCoverHealthThreshold = 0.6f;
+
+        BoneDamageMultipliers = {
+            {TEXT("head"), 2.0f},
+            {TEXT("skull"), 2.0f},
+            {TEXT("spine_03"), 1.5f}, // Upper torso
+            {TEXT("spine_02"), 1.2f}, // Mid torso
+            {TEXT("spine_01"), 1.0f}, // Lower torso
+        };
         
         bCanSpeak = true;
         bCanFight = false;
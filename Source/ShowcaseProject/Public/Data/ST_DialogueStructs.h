@@ -76,6 +76,12 @@ struct FDialogueAction
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     FText ActionText; // For display purposes
 
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FDataTableRowHandle ItemRow; // GiveItem / TakeItem, ActionValue is the quantity
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TSoftObjectPtr<UObject> ActionAsset; // Sound for PlaySound, montage for PlayAnimation
+
     FDialogueAction()
     {
         ActionType = EDialogueActionType::None;
@@ -123,8 +129,9 @@ struct FDialogueNode : public FTableRowBase
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     FText DialogueText;
 
+    // Soft so a dialogue table does not load every line, UDialogueVoiceStreamer brings clips in ahead of use
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    USoundBase* VoiceClip;
+    TSoftObjectPtr<USoundBase> VoiceClip;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     FGameplayTag EmotionTag; // Happy, Angry, Scared, etc.
@@ -141,6 +148,9 @@ struct FDialogueNode : public FTableRowBase
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     TArray<FDialogueAction> EntryActions;
 
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FDialogueAction> ExitActions;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     bool bIsPlayerNode; // If true, this is player dialogue
 
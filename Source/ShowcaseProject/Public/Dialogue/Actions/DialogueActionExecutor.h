@@ -0,0 +1,102 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Data/ST_DialogueStructs.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DialogueActionExecutor.generated.h"
+
+class ANPC_BaseCharacter;
+class UAudioComponent;
+class UInventoryComponent;
+class UAnimMontage;
+class USoundBase;
+
+// Who an action is applied between
+struct FDialogueActionContext
+{
+	TWeakObjectPtr<ANPC_BaseCharacter> Speaker;
+	TWeakObjectPtr<AActor> Partner;
+};
+
+DECLARE_DELEGATE_TwoParams(FDialogueActionHandler, const FDialogueAction& /*Action*/, const FDialogueActionContext& /*Context*/);
+
+USTRUCT()
+struct FQueuedDialogueAction
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	FDialogueAction Action;
+
+	FDialogueActionContext Context;
+};
+
+/**
+ * Applies dialogue actions in one batch at the end of the world tick. Item actions share a single inventory
+ * transaction, sounds play from a small pool of audio components and animations become montage requests.
+ * Systems extend the executor by registering handlers for an ActionTag; a handler registered for a parent
+ * tag also receives its children, and tagged handlers take precedence over the built-in ActionType behaviour.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UDialogueActionExecutor : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	void QueueAction(const FDialogueAction& Action, const FDialogueActionContext& Context);
+
+	void RegisterHandler(FGameplayTag ActionTag, FDialogueActionHandler Handler);
+	void UnregisterHandler(FGameplayTag ActionTag);
+
+	// Applies everything queued so far, normally called at the end of the world tick
+	void FlushActions();
+
+	// Applies only the queued built-in actions that dialogue conditions read (items, quests, relations), so
+	// conditions evaluated this frame already see them. Everything else still waits for FlushActions
+	void FlushStateActions();
+
+private:
+	UPROPERTY()
+	TArray<FQueuedDialogueAction> PendingActions;
+
+	// Swapped with PendingActions while flushing so handlers can queue follow-ups for the next batch
+	UPROPERTY()
+	TArray<FQueuedDialogueAction> ExecutingActions;
+
+	TMap<FGameplayTag, FDialogueActionHandler> Handlers;
+
+	UPROPERTY()
+	TArray<UAudioComponent*> AudioPool;
+
+	// Audio components kept around for action sounds, further sounds steal the oldest one
+	static constexpr int32 MaxPooledAudioComponents = 8;
+	int32 NextAudioSteal = 0;
+
+	// Inventories touched during the current flush, each gets a single update broadcast
+	TArray<TWeakObjectPtr<UInventoryComponent>> BatchedInventories;
+
+	FDelegateHandle PostActorTickHandle;
+
+	void HandlePostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	const FDialogueActionHandler* FindHandler(FGameplayTag ActionTag) const;
+	void ExecuteQueuedAction(const FQueuedDialogueAction& QueuedAction);
+	void EndInventoryBatches();
+	void ExecuteBuiltInAction(const FDialogueAction& Action, const FDialogueActionContext& Context);
+
+	UInventoryComponent* GetBatchedInventory(const FDialogueActionContext& Context);
+	void GiveItem(const FDialogueAction& Action, const FDialogueActionContext& Context);
+	void TakeItem(const FDialogueAction& Action, const FDialogueActionContext& Context);
+	void SetFact(FGameplayTag FactTag, float Value, bool bAdditive) const;
+	void PlayActionAsset(UObject* Asset, bool bIsSound, const FDialogueActionContext& Context);
+	void PlaySound(USoundBase* Sound, const FDialogueActionContext& Context);
+	void PlayMontage(UAnimMontage* Montage, const FDialogueActionContext& Context) const;
+	UAudioComponent* AcquireAudioComponent();
+	void HandleAudioFinished(UAudioComponent* AudioComponent);
+};
@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DialogueVoiceStreamer.generated.h"
+
+class UDialogueGraph;
+class USoundBase;
+struct FStreamableHandle;
+
+DECLARE_DELEGATE_OneParam(FOnVoiceClipReady, USoundBase* /*VoiceClip*/);
+
+/**
+ * Keeps the voice clips of the current dialogue node and of the nodes reachable from it resident.
+ * Entering a node prefetches what the next lines may need and releases clips that can no longer be reached,
+ * so a dialogue table no longer pulls every line into memory.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UDialogueVoiceStreamer : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Holds the clips of NodeIndex and of every node up to PrefetchDepth choices away, releases the rest
+	void PrefetchFromNode(const UDialogueGraph* Graph, int32 NodeIndex, int32 PrefetchDepth);
+
+	// Calls OnReady with the clip, right away when it is resident or once it finished loading
+	void RequestVoiceClip(const TSoftObjectPtr<USoundBase>& VoiceClip, FOnVoiceClipReady OnReady);
+
+	// Drops every held clip, called when a conversation ends
+	void ReleaseAll();
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue | Voice")
+	float GetCacheHitRate() const;
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue | Voice")
+	FORCEINLINE int32 GetNumHeldClips() const { return HeldClips.Num(); }
+
+private:
+	TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> HeldClips;
+
+	// Reused between prefetches
+	TSet<FSoftObjectPath> WantedClips;
+	TArray<int32> Frontier;
+	TArray<int32> NextFrontier;
+	TBitArray<> VisitedNodes;
+
+	int32 CacheHits = 0;
+	int32 CacheMisses = 0;
+
+	// Whether this conversation prefetched anything yet, its first line is never counted
+	bool bHasPrefetched = false;
+
+	void HoldClip(const FSoftObjectPath& ClipPath);
+};
@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "DialogueBarkSubsystem.generated.h"
+
+class ANPC_BaseCharacter;
+class UAudioComponent;
+class UDialogueGraph;
+class USoundBase;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnBarkSubtitle, ANPC_BaseCharacter*, Speaker, const FText&, SubtitleText, float, Duration);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBarkEnded, ANPC_BaseCharacter*, Speaker);
+
+// Once the budget is spent a bark only plays by taking the slot of a lower priority one
+UENUM(BlueprintType)
+enum class EBarkPriority : uint8
+{
+	Ambient,
+	Reaction,
+	Combat,
+	Critical
+};
+
+struct FPendingBark
+{
+	TWeakObjectPtr<ANPC_BaseCharacter> Speaker;
+	FGameplayTag BarkTag;
+	EBarkPriority Priority = EBarkPriority::Ambient;
+	float DistanceSquared = 0.0f;
+};
+
+struct FActiveBark
+{
+	TWeakObjectPtr<ANPC_BaseCharacter> Speaker;
+	EBarkPriority Priority = EBarkPriority::Ambient;
+	double EndTime = 0.0;
+	bool bHasSubtitle = false;
+
+	// Bumped every time the slot is reused so late clip loads can tell they were preempted
+	uint32 Serial = 0;
+
+	FORCEINLINE bool IsActive() const { return EndTime > 0.0; }
+};
+
+/**
+ * Schedules short ambient lines ("barks") for any number of NPCs from the same compiled dialogue graphs that
+ * drive conversations. Bark lines are dialogue nodes tagged under Bark.*, picked by their entry conditions.
+ * Requests are collected during the frame and resolved once at the end of it: NPCs the player cannot hear are
+ * dropped on request, before any condition is evaluated, each NPC has a cooldown, and a global voice and
+ * subtitle budget decides what actually plays, by priority and then by distance.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UDialogueBarkSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Asks Speaker to say a line tagged under BarkTag, returns false when the request was culled right away
+	UFUNCTION(BlueprintCallable, Category = "Dialogue | Barks")
+	bool RequestBark(ANPC_BaseCharacter* Speaker, FGameplayTag BarkTag, EBarkPriority Priority);
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue | Barks")
+	bool IsBarking(const ANPC_BaseCharacter* Speaker) const;
+
+	UPROPERTY(BlueprintAssignable, Category = "Dialogue | Barks")
+	FOnBarkSubtitle OnBarkSubtitle;
+
+	UPROPERTY(BlueprintAssignable, Category = "Dialogue | Barks")
+	FOnBarkEnded OnBarkEnded;
+
+	// Barks further than this from the listener are never evaluated
+	static constexpr float MaxBarkDistance = 2500.0f;
+
+	// Barks playing at once across the world, and how many of them may show a subtitle
+	static constexpr int32 MaxConcurrentBarks = 3;
+	static constexpr int32 MaxBarkSubtitles = 2;
+
+	// Seconds an NPC stays quiet after starting a bark
+	static constexpr float BarkCooldown = 8.0f;
+
+	// Length of a bark whose clip is not loaded yet or that has no clip
+	static constexpr float MinBarkDuration = 1.5f;
+	static constexpr float SecondsPerSubtitleCharacter = 0.06f;
+
+private:
+	UPROPERTY()
+	TArray<UAudioComponent*> AudioPool;
+
+	// One entry per audio pool slot
+	TArray<FActiveBark> ActiveBarks;
+
+	TArray<FPendingBark> PendingBarks;
+
+	TMap<TObjectKey<ANPC_BaseCharacter>, double> NextBarkTimes;
+
+	// Bark node indices of a graph under a bark tag, built on first use
+	TMap<TPair<TObjectKey<UDialogueGraph>, FGameplayTag>, TArray<int32>> BarkNodeCache;
+
+	int32 NumActiveSubtitles = 0;
+	uint32 NextBarkSerial = 0;
+
+	FDelegateHandle PostActorTickHandle;
+
+	void HandlePostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	bool GetListenerLocation(FVector& OutLocation) const;
+
+	void ExpireBarks(double Now);
+	void StopBark(int32 Slot);
+
+	// Free slot, or the lowest priority bark below Priority to preempt, INDEX_NONE when the budget is spent
+	int32 FindBarkSlot(EBarkPriority Priority) const;
+
+	// Picks a node under BarkTag whose entry conditions pass for Speaker
+	int32 SelectBarkNode(const ANPC_BaseCharacter& Speaker, const UDialogueGraph& Graph, FGameplayTag BarkTag);
+	const TArray<int32>& GetBarkNodes(const UDialogueGraph& Graph, FGameplayTag BarkTag);
+
+	bool StartBark(int32 Slot, const FPendingBark& Request, double Now);
+	void PlayBarkClip(int32 Slot, uint32 Serial, USoundBase* Clip);
+	UAudioComponent* GetSlotAudioComponent(int32 Slot);
+};
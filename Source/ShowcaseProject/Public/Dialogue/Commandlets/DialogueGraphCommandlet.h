@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GameplayTagContainer.h"
+#include "DialogueGraphCommandlet.generated.h"
+
+class UDataTable;
+class UDialogueGraph;
+
+/**
+ * Validates every dialogue table referenced from NPC data and benchmarks traversals through the production
+ * UDialogueComponent logic. Returns non-zero when content errors are found so CI can fail the build.
+ *
+ * UnrealEditor-Cmd ShowcaseProject -run=DialogueGraph [-Iterations=1000] [-MaxSteps=256] [-NoBenchmark]
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UDialogueGraphCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UDialogueGraphCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	// Dialogue tables mapped to the entry nodes NPCs start them from
+	void GatherDialogueTables(TMap<UDataTable*, TArray<FGameplayTag>>& OutEntryTags) const;
+
+	// Returns the number of errors found
+	int32 ValidateGraph(const UDialogueGraph& Graph, const TArray<int32>& EntryNodes) const;
+
+	void BenchmarkGraph(UDialogueGraph& Graph, const TArray<int32>& EntryNodes, int32 Iterations, int32 MaxSteps) const;
+};
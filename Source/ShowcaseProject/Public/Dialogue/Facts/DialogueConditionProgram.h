@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/ST_DialogueStructs.h"
+#include "DialogueConditionProgram.generated.h"
+
+class UDialogueFactSubsystem;
+
+UENUM()
+enum class EDialogueConditionOp : uint8
+{
+	AlwaysTrue,
+	AlwaysFalse,
+	FactGreaterOrEqual,
+	FactEqual,
+	NPCHealthGreaterOrEqual
+};
+
+// Values a condition program reads, gathered once per evaluation
+struct FDialogueConditionContext
+{
+	TConstArrayView<float> Facts;
+	float NPCHealthFraction = 0.0f;
+};
+
+/**
+ * One compiled FDialogueCondition. Fact lookups are resolved to slots at compile time so evaluating
+ * a condition is a single compare against the fact array.
+ */
+USTRUCT()
+struct FDialogueConditionOp
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	EDialogueConditionOp Op = EDialogueConditionOp::AlwaysTrue;
+
+	UPROPERTY()
+	int32 FactSlot = INDEX_NONE;
+
+	UPROPERTY()
+	float Value = 0.0f;
+
+	// Facts may be null (e.g. offline tools), fact reads then see 0
+	static FDialogueConditionOp Compile(const FDialogueCondition& Condition, UDialogueFactSubsystem* Facts);
+
+	// True when every op passes
+	static bool EvaluateAll(TConstArrayView<FDialogueConditionOp> Ops, const FDialogueConditionContext& Context);
+
+	FORCEINLINE bool Evaluate(const FDialogueConditionContext& Context) const
+	{
+		switch (Op)
+		{
+		case EDialogueConditionOp::AlwaysTrue:
+			return true;
+		case EDialogueConditionOp::FactGreaterOrEqual:
+			return ReadFact(Context) >= Value;
+		case EDialogueConditionOp::FactEqual:
+			return FMath::IsNearlyEqual(ReadFact(Context), Value);
+		case EDialogueConditionOp::NPCHealthGreaterOrEqual:
+			return Context.NPCHealthFraction >= Value;
+		default:
+			return false;
+		}
+	}
+
+private:
+	FORCEINLINE float ReadFact(const FDialogueConditionContext& Context) const
+	{
+		return Context.Facts.IsValidIndex(FactSlot) ? Context.Facts[FactSlot] : 0.0f;
+	}
+};
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "DialogueFactSubsystem.generated.h"
+
+class UInventoryComponent;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnDialogueFactChanged, FGameplayTag /*FactTag*/, float /*NewValue*/);
+
+/**
+ * Tag-keyed store of world facts (item counts, quest states, faction values) read by compiled dialogue
+ * conditions. Each fact tag gets a stable slot so conditions resolve to a single array read. Values are
+ * pushed in by the systems that own them (inventory updates, dialogue actions) instead of being polled.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UDialogueFactSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Returns the slot for a fact, registering it on first use. Slots are never reused
+	int32 GetOrAddFactSlot(FGameplayTag FactTag);
+
+	UFUNCTION(BlueprintCallable, Category = "Dialogue | Facts")
+	void SetFact(FGameplayTag FactTag, float Value);
+
+	UFUNCTION(BlueprintCallable, Category = "Dialogue | Facts")
+	void AddToFact(FGameplayTag FactTag, float Delta);
+
+	// Unknown facts read as 0
+	UFUNCTION(BlueprintPure, Category = "Dialogue | Facts")
+	float GetFact(FGameplayTag FactTag) const;
+
+	FORCEINLINE TConstArrayView<float> GetFactValues() const { return FactValues; }
+
+	// Bumped on every change, lets consumers cache condition results
+	FORCEINLINE uint32 GetFactsVersion() const { return FactsVersion; }
+
+	// Mirrors item counts of the inventory into Fact.Item.<ItemID> facts
+	void BindInventory(UInventoryComponent* Inventory);
+
+	FOnDialogueFactChanged OnFactChanged;
+
+private:
+	TMap<FGameplayTag, int32> FactSlotByTag;
+	TArray<FGameplayTag> FactTags;
+	TArray<float> FactValues;
+
+	// Item fact slots keyed by the ItemID they count
+	TMap<FName, int32> ItemFactSlots;
+
+	TWeakObjectPtr<UInventoryComponent> BoundInventory;
+	FDelegateHandle InventoryUpdatedHandle;
+
+	uint32 FactsVersion = 0;
+
+	void SetFactSlot(int32 Slot, float Value);
+	void RefreshInventoryFacts();
+};
@@ -0,0 +1,173 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "GameplayTagContainer.h"
+#include "Data/ST_DialogueStructs.h"
+#include "Dialogue/Facts/DialogueConditionProgram.h"
+#include "DialogueGraph.generated.h"
+
+class UDataTable;
+class UDialogueFactSubsystem;
+
+USTRUCT()
+struct FDialogueGraphChoice
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	FText ChoiceText;
+
+	// Authored target, kept for validation and for ending on unresolved edges
+	UPROPERTY()
+	FGameplayTag NextNodeTag;
+
+	// Resolved target node, INDEX_NONE when NextNodeTag is empty or does not exist in the table
+	UPROPERTY()
+	int32 NextNodeIndex = INDEX_NONE;
+
+	UPROPERTY()
+	int32 FirstCondition = 0;
+
+	UPROPERTY()
+	int32 NumConditions = 0;
+
+	UPROPERTY()
+	int32 FirstAction = 0;
+
+	UPROPERTY()
+	int32 NumActions = 0;
+
+	UPROPERTY()
+	bool bEndsDialogue = false;
+};
+
+// Valid choices of a node as a bitmask over the node's choice indices, built without allocating
+struct FDialogueChoiceSet
+{
+	static constexpr int32 MaxChoices = 64;
+
+	uint64 ValidMask = 0;
+
+	FORCEINLINE void Add(int32 ChoiceIndex) { ValidMask |= (1ull << ChoiceIndex); }
+	FORCEINLINE bool Contains(int32 ChoiceIndex) const { return ChoiceIndex >= 0 && ChoiceIndex < MaxChoices && (ValidMask & (1ull << ChoiceIndex)) != 0; }
+	FORCEINLINE bool IsEmpty() const { return ValidMask == 0; }
+	FORCEINLINE int32 Num() const { return FMath::CountBits(ValidMask); }
+	FORCEINLINE int32 GetFirst() const { return ValidMask ? static_cast<int32>(FMath::CountTrailingZeros64(ValidMask)) : INDEX_NONE; }
+	FORCEINLINE void Reset() { ValidMask = 0; }
+
+	// Calls Func(ChoiceIndex) for each valid choice in ascending order
+	template<typename FuncType>
+	void ForEach(FuncType&& Func) const
+	{
+		for (uint64 Remaining = ValidMask; Remaining; Remaining &= Remaining - 1)
+		{
+			Func(static_cast<int32>(FMath::CountTrailingZeros64(Remaining)));
+		}
+	}
+};
+
+USTRUCT()
+struct FDialogueGraphNode
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	FGameplayTag NodeTag;
+
+	// Row the node was compiled from
+	UPROPERTY()
+	FName RowName;
+
+	UPROPERTY()
+	int32 FirstChoice = 0;
+
+	UPROPERTY()
+	int32 NumChoices = 0;
+
+	UPROPERTY()
+	int32 FirstEntryCondition = 0;
+
+	UPROPERTY()
+	int32 NumEntryConditions = 0;
+
+	UPROPERTY()
+	int32 FirstEntryAction = 0;
+
+	UPROPERTY()
+	int32 NumEntryActions = 0;
+
+	UPROPERTY()
+	int32 FirstExitAction = 0;
+
+	UPROPERTY()
+	int32 NumExitActions = 0;
+};
+
+/**
+ * Immutable, compiled form of a dialogue UDataTable. Nodes are addressed by dense index, choice edges are
+ * resolved to node indices up front and all conditions/actions live in flat arrays referenced by range.
+ * One graph is shared by every NPC using the same table.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UDialogueGraph : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// Builds a graph from a table whose rows are FDialogueNode, returns null for anything else.
+	// Conditions are compiled against the fact slots of Facts
+	static UDialogueGraph* Compile(UDataTable* DialogueTable, UObject* Outer, UDialogueFactSubsystem* Facts);
+
+	FORCEINLINE int32 NumNodes() const { return Nodes.Num(); }
+	FORCEINLINE bool IsValidNodeIndex(int32 NodeIndex) const { return Nodes.IsValidIndex(NodeIndex); }
+	FORCEINLINE UDataTable* GetSourceTable() const { return SourceTable; }
+
+	int32 FindNodeIndex(FGameplayTag NodeTag) const;
+
+	FORCEINLINE const FDialogueGraphNode& GetNode(int32 NodeIndex) const { return Nodes[NodeIndex]; }
+
+	// Presentation data for the node (speaker, text, voice...). Its choice/condition/action arrays are empty,
+	// use the graph accessors for those
+	FORCEINLINE const FDialogueNode& GetNodeData(int32 NodeIndex) const { return NodeData[NodeIndex]; }
+
+	TConstArrayView<FDialogueGraphChoice> GetChoices(int32 NodeIndex) const;
+	TConstArrayView<FDialogueCondition> GetConditions(int32 First, int32 Num) const;
+	TConstArrayView<FDialogueAction> GetActions(int32 First, int32 Num) const;
+
+	// Compiled form of GetConditions, same ranges
+	TConstArrayView<FDialogueConditionOp> GetConditionOps(int32 First, int32 Num) const;
+
+	TConstArrayView<FDialogueCondition> GetEntryConditions(int32 NodeIndex) const;
+	TConstArrayView<FDialogueConditionOp> GetEntryConditionOps(int32 NodeIndex) const;
+	TConstArrayView<FDialogueAction> GetEntryActions(int32 NodeIndex) const;
+	TConstArrayView<FDialogueAction> GetExitActions(int32 NodeIndex) const;
+
+private:
+	UPROPERTY()
+	UDataTable* SourceTable;
+
+	UPROPERTY()
+	TArray<FDialogueGraphNode> Nodes;
+
+	UPROPERTY()
+	TArray<FDialogueNode> NodeData;
+
+	UPROPERTY()
+	TArray<FDialogueGraphChoice> Choices;
+
+	UPROPERTY()
+	TArray<FDialogueCondition> Conditions;
+
+	// One op per entry in Conditions
+	UPROPERTY()
+	TArray<FDialogueConditionOp> ConditionOps;
+
+	UPROPERTY()
+	TArray<FDialogueAction> Actions;
+
+	UPROPERTY()
+	TMap<FGameplayTag, int32> NodeIndexByTag;
+};
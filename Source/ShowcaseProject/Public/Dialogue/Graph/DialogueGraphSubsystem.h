@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "DialogueGraphSubsystem.generated.h"
+
+class UDataTable;
+class UDialogueGraph;
+
+/**
+ * Compiles each dialogue table once and hands the same graph to every NPC that uses it.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UDialogueGraphSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Returns the compiled graph for the table, compiling it on first request
+	UDialogueGraph* GetOrCompileGraph(UDataTable* DialogueTable);
+
+	// Drops a cached graph so the next request recompiles it
+	void InvalidateGraph(UDataTable* DialogueTable);
+
+private:
+	UPROPERTY()
+	TMap<UDataTable*, UDialogueGraph*> CompiledGraphs;
+
+#if WITH_EDITOR
+	TMap<TWeakObjectPtr<UDataTable>, FDelegateHandle> TableChangedHandles;
+#endif
+};
@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TimeDilationSubsystem.generated.h"
+
+class UCurveFloat;
+
+USTRUCT()
+struct FTimeDilationRequest
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	FName RequesterId;
+
+	UPROPERTY()
+	float TargetDilation = 1.0f;
+
+	UPROPERTY()
+	int32 Priority = 0;
+
+	// Push order, used to let the most recent request win between equal priorities
+	uint64 Sequence = 0;
+};
+
+/**
+ * Single owner of the global time dilation. Systems (inventory, dialogue, slow-mo effects) push named
+ * requests with a priority; the highest priority request wins and the manager blends towards it over
+ * real time, applying at most one SetGlobalTimeDilation per frame.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UTimeDilationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Adds or updates a request. BlendTime is in real seconds, BlendCurve maps 0..1 time to 0..1 blend (ease-out when null)
+	UFUNCTION(BlueprintCallable, Category = "Time Dilation")
+	void PushTimeDilation(FName RequesterId, float TargetDilation, int32 Priority, float BlendTime = 0.0f, UCurveFloat* BlendCurve = nullptr);
+
+	// Removes a request and blends towards whatever is left on the stack (normal speed when empty)
+	UFUNCTION(BlueprintCallable, Category = "Time Dilation")
+	void PopTimeDilation(FName RequesterId, float BlendTime = 0.0f, UCurveFloat* BlendCurve = nullptr);
+
+	UFUNCTION(BlueprintPure, Category = "Time Dilation")
+	FORCEINLINE float GetCurrentTimeDilation() const { return AppliedDilation; }
+
+	UFUNCTION(BlueprintPure, Category = "Time Dilation")
+	bool HasRequest(FName RequesterId) const;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override { return true; }
+	virtual TStatId GetStatId() const override;
+
+private:
+	UPROPERTY()
+	TArray<FTimeDilationRequest> Requests;
+
+	UPROPERTY()
+	UCurveFloat* ActiveBlendCurve = nullptr;
+
+	uint64 NextSequence = 0;
+
+	float AppliedDilation = 1.0f;
+	float BlendStartDilation = 1.0f;
+	float BlendTargetDilation = 1.0f;
+	double BlendStartRealTime = 0.0;
+	float BlendDuration = 0.0f;
+	bool bIsBlending = false;
+
+	float ResolveTargetDilation() const;
+	void StartBlend(float BlendTime, UCurveFloat* BlendCurve);
+	double GetRealTimeSeconds() const;
+};
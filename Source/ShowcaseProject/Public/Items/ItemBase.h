@@ -66,6 +66,9 @@ public:
 	
 	UFUNCTION(Category= "Item")
 	virtual UItemBase* CreateItemCopy() const;
+
+	// Builds an item from its data table row, quantity is left for the caller to set
+	static UItemBase* CreateFromItemData(UObject* Outer, TSubclassOf<UItemBase> ItemClass, const FItemData& ItemData);
 	
 	UFUNCTION(Category= "Item")
 	FORCEINLINE float GetItemStackWeight() const {return Quantity * ItemNumericData.Weight;};
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Data/FST_NPCDataStruct.h"
+#include "NPCArchetype.generated.h"
+
+/**
+ * One NPC data table row resolved once and shared, read only, by every NPC spawned from it.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UNPCArchetype : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	static UNPCArchetype* Build(const FST_NPCDataStruct& Row, FName RowName, UObject* Outer);
+
+	FORCEINLINE const FST_NPCDataStruct& GetData() const { return Data; }
+	FORCEINLINE FName GetRowName() const { return RowName; }
+
+	// Exact bone match first, then the first multiplier whose key is part of the bone name
+	float GetBoneDamageMultiplier(FName BoneName) const;
+
+private:
+	UPROPERTY()
+	FST_NPCDataStruct Data;
+
+	UPROPERTY()
+	FName RowName;
+
+	// Keys of Data.BoneDamageMultipliers as strings for the partial match, built once instead of per hit
+	TArray<TPair<FString, float>> BoneMultiplierSubstrings;
+};
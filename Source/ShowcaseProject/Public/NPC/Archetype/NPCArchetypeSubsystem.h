@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "NPCArchetypeSubsystem.generated.h"
+
+class UNPCArchetype;
+
+USTRUCT()
+struct FNPCArchetypeTable
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	TMap<FName, UNPCArchetype*> Rows;
+};
+
+/**
+ * Resolves each NPC data table row once into a UNPCArchetype and hands the same object to every NPC of that type,
+ * so instances only carry their mutable state.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UNPCArchetypeSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Returns the archetype for the row, building it on first request, null if the row does not exist
+	const UNPCArchetype* GetOrCreateArchetype(const FDataTableRowHandle& RowHandle);
+
+	// Built from the row defaults, used by NPCs without a data table row
+	const UNPCArchetype* GetDefaultArchetype();
+
+	// Drops the cached archetypes of a table, NPCs already using them keep their copy
+	void InvalidateTable(UDataTable* DataTable);
+
+private:
+	UPROPERTY()
+	TMap<UDataTable*, FNPCArchetypeTable> Tables;
+
+	UPROPERTY()
+	UNPCArchetype* DefaultArchetype = nullptr;
+
+#if WITH_EDITOR
+	TMap<TWeakObjectPtr<UDataTable>, FDelegateHandle> TableChangedHandles;
+#endif
+};
@@ -7,13 +7,16 @@
 #include "Interfaces/DamageableInterface.h"
 #include "Data/FST_NPCDataStruct.h"
 #include "Interfaces/InteractionInterface.h"
+#include "NPC/Cover/NPCCoverSubsystem.h"
 #include "NPC/StateTree/ShowcaseStateTreeComponent.h"
+#include "NPC/Significance/NPCSignificanceSubsystem.h"
 #include "NPC_BaseCharacter.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnWeaponSpotted, AActor*, WeaponHolder, bool, bIsDrawn, float, ReactionIntensity);
 
 
 class ANPC_AIController;
+class UNPCArchetype;
 class UDialogueComponent;
 class UStateTreeComponent;
 class APatrolPath;
@@ -75,6 +78,67 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Dialogue")
 	void EndDialogue();
 
+	// Called by the AI controller when perception sees an armed actor
+	void NotifyWeaponSpotted(AActor* WeaponHolder, bool bIsDrawn, float ReactionIntensity);
+
+	// Alertness and state timing, advanced by UNPCSimulationSubsystem
+	UFUNCTION(BlueprintPure, Category = "State")
+	float GetAlertness() const;
+
+	UFUNCTION(BlueprintPure, Category = "State")
+	float GetTimeInCurrentState() const;
+
+	void RaiseAlertness(float Amount);
+
+	// Alertness decayed below UNPCSimulationSubsystem::CalmAlertness
+	void OnAlertnessCalmed();
+
+	// Health regenerated by UNPCSimulationSubsystem, never lowers what the NPC has
+	void ApplyRegeneratedHealth(float Health);
+
+	FORCEINLINE int32 GetSimulationIndex() const { return SimulationIndex; }
+	FORCEINLINE void SetSimulationIndex(int32 NewIndex) { SimulationIndex = NewIndex; }
+
+	// Cover, read from the baked ANPCCoverData through UNPCCoverSubsystem
+	// Health is below TakeCoverHealthThreshold and this NPC's type takes cover at all
+	UFUNCTION(BlueprintPure, Category = "Combat")
+	bool ShouldTakeCover() const;
+
+	// Finds and claims the best cover from Threat within CoverSearchRadius
+	UFUNCTION(BlueprintCallable, Category = "Combat")
+	bool FindCoverFrom(AActor* Threat, FNPCCoverResult& OutCover);
+
+	UFUNCTION(BlueprintCallable, Category = "Combat")
+	void ReleaseCover();
+
+	static constexpr float CoverSearchRadius = 1500.0f;
+
+	// Significance
+	UFUNCTION(BlueprintPure, Category = "Significance")
+	FORCEINLINE ENPCSignificance GetSignificance() const { return Significance; }
+
+	// Applies the tick and detail budget of a significance bucket, called by UNPCSignificanceSubsystem
+	void ApplySignificance(ENPCSignificance NewSignificance);
+
+	// Ragdoll, budgeted by UNPCRagdollSubsystem
+	void EnableRagdoll(const FVector& ImpulseLocation = FVector::ZeroVector, const FVector& ImpulseDirection = FVector::ZeroVector);
+
+	// Keeps the last simulated pose with physics, collision and animation off
+	void FreezeRagdollPose();
+
+	// Puts the mesh back on the capsule with physics and animation as they were before the ragdoll
+	void ResetRagdoll();
+
+	// Runs the death cleanup now instead of after DeathDelayTime
+	void RecycleCorpse();
+
+	// Pooling, driven by UNPCSpawnerSubsystem
+	// Hides the NPC, switches off its ticking and collision and detaches it from its controller
+	void DeactivateForPool();
+
+	// Brings a pooled NPC back at SpawnTransform with full health, re-possessed by its old controller
+	void ResetForRespawn(const FTransform& SpawnTransform);
+
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
@@ -98,9 +162,11 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NPC Data")
 	FDataTableRowHandle NPCDataHandle;
 
-	// Current NPC Data (cached from data table)
-	UPROPERTY(BlueprintReadOnly, Category = "NPC Data")
-	FST_NPCDataStruct NPCData;
+	// Shared data of this NPC's type, defaults when no row is set
+	UFUNCTION(BlueprintPure, Category = "NPC Data")
+	const FST_NPCDataStruct& GetNPCData() const;
+
+	FORCEINLINE const UNPCArchetype* GetArchetype() const { return Archetype; }
 
 	// State Management
 	UPROPERTY(BlueprintReadOnly, Category = "State")
@@ -116,6 +182,13 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Health")
 	float MaxHealth;
 
+	// Regeneration starts HealthRegenDelay seconds after the last hit, 0 disables it
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Health")
+	float HealthRegenPerSecond = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Health")
+	float HealthRegenDelay = 5.0f;
+
 	// Target Management
 	UPROPERTY(BlueprintReadOnly, Category = "Combat")
 	AActor* CurrentTarget;
@@ -123,6 +196,10 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Combat")
 	AActor* LastKnownPlayerLocation;
 
+	// Route walked by the patrol behavior tree tasks
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
+	APatrolPath* PatrolPath = nullptr;
+
 	// Dialogue System
 	UPROPERTY(BlueprintReadOnly, Category = "Dialogue")
 	bool bIsInDialogue;
@@ -153,8 +230,6 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage")
 	float DeathDelayTime = 10.0f; // Time before cleanup after death
     
-	FTimerHandle DeathCleanupTimer;
-
 	// Damage events
 	UPROPERTY(BlueprintAssignable, Category = "Damage")
 	FOnDamageTaken OnDamageTakenDelegate;
@@ -162,27 +237,20 @@ protected:
 	UPROPERTY(BlueprintAssignable, Category = "Damage")
 	FOnDeath OnDeathDelegate;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage")
-	TMap<FName, float> BoneDamageMultipliers = {
-		{TEXT("head"), 2.0f},
-		{TEXT("Head"), 2.0f},
-		{TEXT("skull"), 2.0f},
-		{TEXT("spine_03"), 1.5f}, // Upper torso
-		{TEXT("spine_02"), 1.2f}, // Mid torso
-		{TEXT("spine_01"), 1.0f}, // Lower torso
-	};
-	
+	UPROPERTY(BlueprintAssignable, Category = "Combat")
+	FOnWeaponSpotted OnWeaponSpotted;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage")
 	float RagdollImpulseStrength = 500.0f;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage")
 	bool bCanRagdoll = true;
 
-	void EnableRagdoll(const FVector& ImpulseLocation = FVector::ZeroVector, const FVector& ImpulseDirection = FVector::ZeroVector);
 	void ApplyDeathImpulse(const FVector& ImpulseLocation, const FVector& ImpulseDirection);
 
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void BeginDestroy() override;
 	
 	// Internal State Management
@@ -205,12 +273,23 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Animation", meta=(AllowPrivateAccess="true"))
 	UAnimMontage* HookMontage;
 
-	// Timer Handles
-	FTimerHandle AlertnessDecayTimer;
-	FTimerHandle HealthRegenerationTimer;
+	ENPCSignificance Significance = ENPCSignificance::Critical;
+
+	// Slot in UNPCSimulationSubsystem's arrays
+	int32 SimulationIndex = INDEX_NONE;
+
+	// Mesh placement on the capsule, restored after a ragdoll detached it
+	FTransform DefaultMeshRelativeTransform;
+
+	// The ragdoll ignores the camera channel, this is what the mesh answered before
+	TEnumAsByte<ECollisionResponse> DefaultMeshCameraResponse = ECR_Block;
+
+	// Kept while the NPC sits in its pool so respawning skips spawning a controller
+	UPROPERTY(Transient)
+	AController* PooledController = nullptr;
 
-	// Internal State
-	float CurrentAlertness;
-	float TimeInCurrentState;
+	// Resolved from NPCDataHandle by UNPCArchetypeSubsystem, shared with every NPC of the same row
+	UPROPERTY(Transient)
+	const UNPCArchetype* Archetype = nullptr;
 
 };
@@ -4,13 +4,17 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "Perception/AIPerceptionTypes.h"
 #include "NPC_AIController.generated.h"
 
 struct FCachedBlackboardData;
+struct FNPCSignificanceSettings;
 class ANPC_BaseCharacter;
 class UAISenseConfig_Sight;
 class UAISenseConfig_Hearing;
-struct FAIStimulus;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnSharedSightUpdated, AActor*, Target, bool, bIsSeen);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnNoiseHeard, FVector, NoiseLocation, AActor*, NoiseInstigator, FName, NoiseTag);
 
 /**
  * 
@@ -33,11 +37,40 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI")
 	UAIPerceptionComponent* AIPerceptionComponent;
 
+	// Controller tick rate, driven by the pawn's significance
+	void ApplySignificance(const FNPCSignificanceSettings& Settings);
+
+	// Sight results published by UNPCPerceptionSubsystem
+	void HandleSightUpdated(AActor* Target, bool bIsSeen);
+
+	// Loses sight of everything currently seen, e.g. before the pawn goes back to its pool
+	void ForgetSeenTargets();
+
+	UFUNCTION(BlueprintPure, Category = "AI")
+	FORCEINLINE bool CanSee(const AActor* Target) const { return SeenActors.Contains(Target); }
+
+	UPROPERTY(BlueprintAssignable, Category = "AI")
+	FOnSharedSightUpdated OnSightUpdated;
+
+	// Merged noise events dispatched by UNPCNoiseSubsystem
+	void HandleNoiseHeard(const FVector& NoiseLocation, AActor* NoiseInstigator, FName NoiseTag);
+
+	// Alertness a heard noise adds to the NPC
+	static constexpr float NoiseAlertness = 0.4f;
+
+	UPROPERTY(BlueprintAssignable, Category = "AI")
+	FOnNoiseHeard OnNoiseHeard;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AI")
+	FVector LastHeardNoiseLocation = FVector::ZeroVector;
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void OnPossess(APawn* InPawn) override;
 	virtual void Tick(float DeltaSeconds) override;
 	
+	// Only holds the sight parameters, sight itself runs in UNPCPerceptionSubsystem
 	UAISenseConfig_Sight* SightConfig;
 	UAISenseConfig_Hearing* HearingConfig;
 
@@ -45,4 +78,6 @@ private:
 	ANPC_BaseCharacter* PossessedNPCCharacter;
 	void SetupPerceptionSystem();
 
+	TArray<TWeakObjectPtr<AActor>> SeenActors;
+	int32 SightListenerId = INDEX_NONE;
 };
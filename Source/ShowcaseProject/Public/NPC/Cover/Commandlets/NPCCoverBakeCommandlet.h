@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "NPCCoverBakeCommandlet.generated.h"
+
+class UWorld;
+
+/**
+ * Bakes ANPCCoverData for each map: loads it, builds its navigation, finds or spawns the cover data actor, bakes
+ * and saves the map. Without -Maps every map in the project is baked. Returns non-zero when a map fails.
+ *
+ * UnrealEditor-Cmd ShowcaseProject -run=NPCCoverBake [-Maps=/Game/Maps/A+/Game/Maps/B] [-NoSave]
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UNPCCoverBakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UNPCCoverBakeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	void GatherMaps(const FString& Params, TArray<FString>& OutMapPackages) const;
+
+	// Returns false when the map could not be loaded or saved
+	bool BakeMap(const FString& MapPackage, bool bSave) const;
+
+	bool SavePackage(UPackage* Package, UObject* Asset, const FString& Extension) const;
+};
@@ -0,0 +1,155 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "NPCCoverData.generated.h"
+
+UENUM(BlueprintType)
+enum class ENPCCoverHeight : uint8
+{
+	// Blocks a crouching NPC, shooting over it is possible
+	Low UMETA(DisplayName = "Low"),
+
+	// Blocks a standing NPC
+	High UMETA(DisplayName = "High"),
+};
+
+// One baked cover point, 16 bytes
+USTRUCT()
+struct FNPCCoverPoint
+{
+	GENERATED_BODY()
+
+	// On the navmesh, where the NPC stands
+	UPROPERTY()
+	FVector3f Location = FVector3f::ZeroVector;
+
+	// Yaw from the point towards the cover geometry, 256 steps per turn
+	UPROPERTY()
+	uint8 PackedYaw = 0;
+
+	UPROPERTY()
+	ENPCCoverHeight Height = ENPCCoverHeight::Low;
+
+	FORCEINLINE FVector GetLocation() const { return FVector(Location); }
+
+	FORCEINLINE FVector GetFacing() const
+	{
+		const float Yaw = PackedYaw * (2.0f * UE_PI / 256.0f);
+		return FVector(FMath::Cos(Yaw), FMath::Sin(Yaw), 0.0f);
+	}
+
+	FORCEINLINE void SetFacing(const FVector& Direction)
+	{
+		const float Yaw = FMath::Atan2(Direction.Y, Direction.X);
+		PackedYaw = static_cast<uint8>(FMath::RoundToInt(Yaw * (256.0f / (2.0f * UE_PI))) & 0xFF);
+	}
+};
+
+// Run of consecutive points in one grid cell
+USTRUCT()
+struct FNPCCoverCell
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FIntPoint Cell = FIntPoint::ZeroValue;
+
+	UPROPERTY()
+	int32 FirstPoint = 0;
+
+	UPROPERTY()
+	int32 NumPoints = 0;
+};
+
+/**
+ * Cover points of a level, baked offline by UNPCCoverBakeCommandlet (or the Bake Cover button) and saved with
+ * the level. Boundary edges of the navmesh are sampled and probed against static geometry at crouch and standing
+ * height; what blocks becomes a cover point with a facing and height class. Points are sorted by grid cell and
+ * the cell table is sorted too, so a radius query is a few binary searches and never touches the environment.
+ * Registers with UNPCCoverSubsystem while in play.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API ANPCCoverData : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+	ANPCCoverData();
+
+	// Calls Func(PointIndex, Point) for every point in the cells within Radius, callers do the exact test
+	template<typename FuncType>
+	void ForEachPointInRadius(const FVector& Center, float Radius, FuncType&& Func) const
+	{
+		const FIntPoint MinCell = GetCell(Center - FVector(Radius));
+		const FIntPoint MaxCell = GetCell(Center + FVector(Radius));
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			// Cells are sorted by X then Y, so each column is one contiguous range
+			for (int32 CellIndex = FindFirstCell(FIntPoint(X, MinCell.Y)); CellIndex < Cells.Num(); ++CellIndex)
+			{
+				const FNPCCoverCell& Cell = Cells[CellIndex];
+				if (Cell.Cell.X != X || Cell.Cell.Y > MaxCell.Y) break;
+
+				for (int32 PointIndex = Cell.FirstPoint; PointIndex < Cell.FirstPoint + Cell.NumPoints; ++PointIndex)
+				{
+					Func(PointIndex, Points[PointIndex]);
+				}
+			}
+		}
+	}
+
+	FORCEINLINE const FNPCCoverPoint& GetPoint(int32 PointIndex) const { return Points[PointIndex]; }
+	FORCEINLINE int32 NumPoints() const { return Points.Num(); }
+
+	static FIntPoint GetCell(const FVector& Location);
+
+	// About the usual search radius, so a query reads a handful of cells
+	static constexpr float CellSize = 1500.0f;
+
+#if WITH_EDITOR
+	// Samples the navmesh of this world and replaces the baked points
+	UFUNCTION(CallInEditor, Category = "Cover")
+	void BakeCover();
+
+	// Distance between samples along a navmesh boundary edge
+	static constexpr float SampleSpacing = 100.0f;
+
+	// How far past the navmesh edge geometry still counts as cover
+	static constexpr float ProbeDistance = 120.0f;
+
+	// Probe heights above the navmesh, crouched chest and standing head
+	static constexpr float LowProbeHeight = 80.0f;
+	static constexpr float HighProbeHeight = 160.0f;
+
+	// Points closer than this with a similar facing are merged
+	static constexpr float MinPointSpacing = 120.0f;
+#endif
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	UPROPERTY()
+	TArray<FNPCCoverPoint> Points;
+
+	UPROPERTY()
+	TArray<FNPCCoverCell> Cells;
+
+	UPROPERTY(VisibleAnywhere, Category = "Cover")
+	int32 NumBakedPoints = 0;
+
+	// Id in UNPCCoverSubsystem while registered
+	int32 RegistryId = INDEX_NONE;
+
+	// Index of the first cell not before Cell
+	int32 FindFirstCell(const FIntPoint& Cell) const;
+
+#if WITH_EDITOR
+	// Sorts Points by cell and rebuilds the cell table
+	void BuildCells();
+#endif
+};
@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NPC/Cover/NPCCoverData.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NPCCoverSubsystem.generated.h"
+
+USTRUCT(BlueprintType)
+struct FNPCCoverResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Cover")
+	FVector Location = FVector::ZeroVector;
+
+	// Towards the cover geometry
+	UPROPERTY(BlueprintReadOnly, Category = "Cover")
+	FVector Facing = FVector::ForwardVector;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Cover")
+	ENPCCoverHeight Height = ENPCCoverHeight::Low;
+
+	int32 DataId = INDEX_NONE;
+	int32 PointIndex = INDEX_NONE;
+
+	FORCEINLINE bool IsSet() const { return DataId != INDEX_NONE; }
+};
+
+/**
+ * Runtime side of the baked cover. Queries only read the ANPCCoverData of the loaded levels: candidates in range
+ * are scored on distance and on how squarely they face the threat, and only the winner gets a line trace from the
+ * threat, the single environment test of a query. Occupied points are skipped, an occupant is dropped once it is
+ * gone or dead.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UNPCCoverSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Returns an id for UnregisterCoverData
+	int32 RegisterCoverData(const ANPCCoverData* CoverData);
+	void UnregisterCoverData(int32 DataId);
+
+	// Best free cover within Radius of Querier that hides it from ThreatLocation, Threat is ignored by the trace.
+	// Returns false when the best point turns out to be exposed, runners-up are never handed out untraced
+	bool FindBestCover(const AActor* Querier, const FVector& ThreatLocation, const AActor* Threat, float Radius, FNPCCoverResult& OutCover) const;
+
+	// Marks the point as taken by User, releasing the point User held before
+	void ClaimCover(const FNPCCoverResult& Cover, AActor* User);
+	void ReleaseCover(const AActor* User);
+
+	// Cover facing further than this from the threat direction does not count
+	static constexpr float MaxThreatAngleDegrees = 50.0f;
+
+	// Cover this close to the threat is no use
+	static constexpr float MinThreatDistance = 400.0f;
+
+	// Score bonus of high cover over low cover, on the scale of one search radius of distance
+	static constexpr float HighCoverBonus = 0.25f;
+
+	// Height the visibility trace aims at above the point
+	static constexpr float LowCoverTraceHeight = 60.0f;
+	static constexpr float HighCoverTraceHeight = 120.0f;
+
+private:
+	TSparseArray<TWeakObjectPtr<const ANPCCoverData>> CoverDataById;
+
+	// Keyed by MakeCoverKey(DataId, PointIndex)
+	TMap<uint64, TWeakObjectPtr<AActor>> Occupants;
+	TMap<TObjectKey<AActor>, uint64> CoverByUser;
+
+	FORCEINLINE static uint64 MakeCoverKey(int32 DataId, int32 PointIndex)
+	{
+		return (static_cast<uint64>(static_cast<uint32>(DataId)) << 32) | static_cast<uint32>(PointIndex);
+	}
+
+	bool IsOccupied(uint64 CoverKey, const AActor* Querier) const;
+	bool IsExposed(const FNPCCoverResult& Cover, const FVector& ThreatLocation, const AActor* Querier, const AActor* Threat) const;
+};
@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "NPC/Character/NPC_BaseCharacter.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NPCCrowdSubsystem.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+// Everything kept of an NPC while it is a crowd proxy
+USTRUCT()
+struct FNPCCrowdAgent
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	TSubclassOf<ANPC_BaseCharacter> NPCClass;
+
+	UPROPERTY()
+	FDataTableRowHandle NPCDataHandle;
+
+	UPROPERTY()
+	FTransform Transform;
+
+	UPROPERTY()
+	ENPCState State = ENPCState::Idle;
+
+	// Where the NPC was walking to when it was demoted, the proxy keeps heading there
+	UPROPERTY()
+	FVector MoveTarget = FVector::ZeroVector;
+
+	UPROPERTY()
+	bool bHasMoveTarget = false;
+
+	UPROPERTY()
+	float Health = 0.0f;
+
+	UPROPERTY()
+	UInstancedStaticMeshComponent* Instances = nullptr;
+
+	UPROPERTY()
+	int32 InstanceIndex = INDEX_NONE;
+};
+
+/**
+ * Demotes distant, uninvolved NPCs to data-only crowd agents drawn as instances of their CrowdProxyMesh, one
+ * instanced mesh component per mesh. Per-instance custom data carries the NPC state (0) and an animation phase
+ * (1) for the vertex animation material. Agents walk straight towards their last move target at a low rate and
+ * are turned back into full actors, a few per frame, once the player comes close again.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UNPCCrowdSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Queues NPC for demotion, it is checked and converted during the next ticks
+	void RequestDemotion(ANPC_BaseCharacter* NPC);
+
+	UFUNCTION(BlueprintPure, Category = "NPC | Crowd")
+	FORCEINLINE int32 GetNumCrowdAgents() const { return Agents.Num(); }
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	// NPCs further than DemoteDistance become proxies, proxies closer than RehydrateDistance become actors again
+	static constexpr float DemoteDistance = 6000.0f;
+	static constexpr float RehydrateDistance = 5000.0f;
+
+	static constexpr int32 MaxDemotionsPerFrame = 4;
+	static constexpr int32 MaxRehydrationsPerFrame = 1;
+
+	// Proxy movement runs at this interval
+	static constexpr float SimulationInterval = 0.2f;
+	static constexpr float AgentWalkSpeed = 150.0f;
+
+private:
+	UPROPERTY()
+	TArray<FNPCCrowdAgent> Agents;
+
+	// Owns the instanced mesh components
+	UPROPERTY()
+	AActor* CrowdHost = nullptr;
+
+	UPROPERTY()
+	TMap<UStaticMesh*, UInstancedStaticMeshComponent*> InstancesByMesh;
+
+	TArray<TWeakObjectPtr<ANPC_BaseCharacter>> PendingDemotions;
+
+	float TimeSinceSimulation = 0.0f;
+
+	bool GetViewLocation(FVector& OutLocation) const;
+
+	void ProcessDemotions(const FVector& ViewLocation);
+	bool CanDemote(const ANPC_BaseCharacter& NPC, const FVector& ViewLocation) const;
+	void DemoteNPC(ANPC_BaseCharacter& NPC, UStaticMesh& ProxyMesh);
+
+	void ProcessRehydrations(const FVector& ViewLocation);
+	bool RehydrateAgent(const FNPCCrowdAgent& Agent);
+	void RemoveAgent(int32 AgentIndex);
+
+	void SimulateAgents(float DeltaTime);
+
+	UInstancedStaticMeshComponent* GetOrCreateInstances(UStaticMesh* ProxyMesh);
+};
@@ -3,12 +3,25 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "NavigationData.h"
 #include "NPC/SmartObject/SmartObject.h"
 #include "PatrolPath.generated.h"
 
+// Navmesh path of one leg, from a patrol point to the next one
+struct FPatrolPathSegment
+{
+	// Kept alive so the navmesh invalidates it when one of its tiles is rebuilt
+	FNavPathSharedPtr Path;
+	FDelegateHandle ObserverHandle;
+
+	bool bIsPartial = false;
+};
 
 /**
- * 
+ * Patrol route through PatrolPoints, offsets local to the actor. The navmesh path of each leg is found once, on
+ * first use, and shared by every NPC on the route: followers get their own copy of the points, forwards or
+ * reversed, and never pathfind a leg themselves. The cached paths stay registered with the navmesh, so a tile
+ * rebuild drops only the legs crossing it and those are found again the next time they are needed.
  */
 UCLASS()
 class SHOWCASEPROJECT_API APatrolPath : public ASmartObject
@@ -21,7 +34,30 @@ public:
 
 	FVector GetPatrolPoint(int32 Index) const;
 	int Num() const;
-	
+
+	// Patrol point in world space
+	FVector GetPatrolPointLocation(int32 Index) const;
+
+	// Path from patrol point FromIndex to its neighbour ToIndex, either way round the route, for one follower.
+	// Null when the points are not neighbours or the navmesh has no path between them.
+	FNavPathSharedPtr GetLegPath(int32 FromIndex, int32 ToIndex);
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Patrol Path", meta = (AllowPrivateAccess = "true", MakeEditWidget = "true"))
 	TArray<FVector> PatrolPoints;
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void OnConstruction(const FTransform& Transform) override;
+
+private:
+	// Segment Index runs from point Index to point Index + 1, the last one closes the loop
+	TArray<FPatrolPathSegment> Segments;
+
+	// Returns the cached segment, finding its path first when there is none
+	const FPatrolPathSegment* GetOrBuildSegment(int32 SegmentIndex);
+
+	void ResetSegment(FPatrolPathSegment& Segment);
+	void ResetSegments();
+
+	void HandleSegmentPathEvent(FNavigationPath* Path, ENavPathEvent::Type Event);
 };
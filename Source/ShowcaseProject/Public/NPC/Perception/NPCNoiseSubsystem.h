@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NPCNoiseSubsystem.generated.h"
+
+struct FNPCNoiseEvent
+{
+	FVector Location = FVector::ZeroVector;
+
+	// Scales the listener's hearing range, 1 is heard exactly at HearingRange
+	float Loudness = 1.0f;
+
+	TWeakObjectPtr<AActor> Instigator;
+	FName Tag;
+
+	// When the event was first reported, merging window starts here
+	double Time = 0.0;
+
+	int32 NumMerged = 1;
+	bool bDispatched = false;
+};
+
+/**
+ * Collects the noises of a frame (gunshots, reloads, impacts) and dispatches them once at the end of the world
+ * tick through the NPC listener grid of UNPCPerceptionSubsystem. Noises with the same tag close in space and time
+ * fold into one event, so automatic fire reaches each NPC a few times per second rather than once per bullet;
+ * a merged noise is only dispatched again when it gets clearly louder.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UNPCNoiseSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	void ReportNoise(const FVector& Location, float Loudness, AActor* Instigator, FName Tag);
+
+	// Noises with the same tag within this distance and time of an earlier one are merged into it
+	static constexpr float MergeRadius = 400.0f;
+	static constexpr float MergeWindow = 0.3f;
+
+	// How much louder a merged noise has to be to be dispatched again
+	static constexpr float RedispatchLoudnessRatio = 1.5f;
+
+private:
+	TArray<FNPCNoiseEvent> Events;
+
+	FDelegateHandle PostActorTickHandle;
+
+	void HandlePostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void DispatchEvent(const FNPCNoiseEvent& Event) const;
+};
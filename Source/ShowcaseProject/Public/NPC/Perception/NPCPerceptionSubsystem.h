@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NPC/Significance/NPCSignificanceSubsystem.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "World/SpatialHashGrid.h"
+#include "WorldCollision.h"
+#include "NPCPerceptionSubsystem.generated.h"
+
+class ANPC_AIController;
+
+struct FSharedSightListener
+{
+	TWeakObjectPtr<ANPC_AIController> Controller;
+
+	float SightRadius = 0.0f;
+	float LoseSightRadius = 0.0f;
+	float CosHalfAngle = 0.0f;
+	float HearingRange = 0.0f;
+
+	double NextCheckTime = 0.0;
+
+	// Frame the listener was last scheduled in, so every target near it gets checked in that same frame
+	uint64 ScheduledFrame = 0;
+
+	// Line of sight checks queued or in flight, the listener is not rescheduled until they are back
+	int32 NumPendingChecks = 0;
+
+	// Published again only when this changes
+	TArray<TWeakObjectPtr<AActor>, TInlineAllocator<2>> SeenTargets;
+};
+
+struct FSharedSightCheck
+{
+	int32 ListenerId = INDEX_NONE;
+	TWeakObjectPtr<ANPC_AIController> Controller;
+	TWeakObjectPtr<AActor> Target;
+	ENPCSignificance Significance = ENPCSignificance::Critical;
+};
+
+/**
+ * Sight for every NPC in one place. Listeners live in a spatial grid (also used to dispatch noise); each frame
+ * every sight target queries the grid once, listeners that are due (how often depends on their significance) get
+ * a range and cone test, and the survivors queue a line of sight check. At most MaxTracesPerFrame async traces
+ * are issued per frame, most significant listeners first, and changes are published to the controllers when the
+ * traces come back. Seen targets that left a listener's lose sight radius are dropped every frame, whether or not
+ * the grid pass reached that listener.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UNPCPerceptionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Returns a listener id for UnregisterListener
+	int32 RegisterListener(ANPC_AIController* Controller, float SightRadius, float LoseSightRadius, float PeripheralVisionAngleDegrees, float HearingRange);
+	void UnregisterListener(int32 ListenerId);
+
+	// Publishes lost sight of every target the listener currently sees
+	void ForgetSeenTargets(int32 ListenerId);
+
+	// Calls Func(Controller, HearingRange) for every listener in the grid cells within Radius, callers do the exact test
+	template<typename FuncType>
+	void ForEachListenerInRadius(const FVector& Location, float Radius, FuncType&& Func) const
+	{
+		ListenerGrid.ForEachInRadius(Location, Radius, [this, &Func](int32 ListenerId)
+		{
+			const FSharedSightListener& Listener = Listeners[ListenerId];
+			if (ANPC_AIController* Controller = Listener.Controller.Get())
+			{
+				Func(Controller, Listener.HearingRange);
+			}
+		});
+	}
+
+	FORCEINLINE float GetMaxHearingRange() const { return MaxHearingRange; }
+
+	// Actors NPCs can see, e.g. the player
+	void RegisterSightTarget(AActor* Target);
+	void UnregisterSightTarget(AActor* Target);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	// Line of sight traces issued per frame across all NPCs
+	static constexpr int32 MaxTracesPerFrame = 8;
+
+	// Roughly the sight radius, so a query touches a handful of cells
+	static constexpr float GridCellSize = 2000.0f;
+
+private:
+	TSparseArray<FSharedSightListener> Listeners;
+	TSpatialHashGrid<int32> ListenerGrid{GridCellSize};
+
+	TArray<TWeakObjectPtr<AActor>> SightTargets;
+
+	// Queued in schedule order, issued from the front
+	TArray<FSharedSightCheck> PendingChecks;
+
+	// Keyed by the trace user data
+	TMap<uint32, FSharedSightCheck> InFlightChecks;
+	uint32 NextTraceId = 0;
+
+	float MaxLoseSightRadius = 0.0f;
+	float MaxHearingRange = 0.0f;
+
+	FTraceDelegate TraceDelegate;
+
+	void UpdateListenerGrid();
+	void ScheduleChecks(AActor& Target, double Now);
+	void ExpireSeenTargets();
+	void IssueTraces();
+	void HandleTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	void PublishSight(int32 ListenerId, AActor* Target, bool bSeen);
+};
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NPCRagdollSubsystem.generated.h"
+
+class ANPC_BaseCharacter;
+
+struct FNPCRagdollEntry
+{
+	TWeakObjectPtr<ANPC_BaseCharacter> NPC;
+
+	double StartTime = 0.0;
+
+	// How long the body has been below SettleSpeed without a break
+	float SettledTime = 0.0f;
+};
+
+/**
+ * Budget for death ragdolls. At most MaxSimulatingRagdolls bodies simulate at once; a body that comes to rest (or
+ * runs out of MaxSimulateTime) is frozen in its last pose with physics, collision and animation off. When the budget
+ * is full the oldest simulating body is frozen early to make room, and past MaxFrozenCorpses the oldest corpse is
+ * recycled without waiting for its death cleanup.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UNPCRagdollSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Starts simulating the NPC's ragdoll, freezing the oldest simulating body if the budget is full
+	void RequestRagdoll(ANPC_BaseCharacter* NPC, const FVector& ImpulseLocation, const FVector& ImpulseDirection);
+
+	// Forgets the NPC, e.g. before it is destroyed or reused. Putting the mesh back is ANPC_BaseCharacter::ResetRagdoll
+	void ReleaseRagdoll(ANPC_BaseCharacter* NPC);
+
+	FORCEINLINE int32 GetNumSimulating() const { return Simulating.Num(); }
+	FORCEINLINE int32 GetNumFrozen() const { return Frozen.Num(); }
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	static constexpr int32 MaxSimulatingRagdolls = 6;
+	static constexpr int32 MaxFrozenCorpses = 16;
+
+	// Root body speed (cm/s) below which a ragdoll counts as resting, and for how long before it is frozen
+	static constexpr float SettleSpeed = 15.0f;
+	static constexpr float SettleTime = 0.5f;
+
+	// Bodies still tumbling after this are frozen anyway
+	static constexpr float MaxSimulateTime = 5.0f;
+
+private:
+	// Both oldest first
+	TArray<FNPCRagdollEntry> Simulating;
+	TArray<TWeakObjectPtr<ANPC_BaseCharacter>> Frozen;
+
+	void FreezeOldestSimulating();
+	void Freeze(ANPC_BaseCharacter& NPC);
+};
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NPCSignificanceSubsystem.generated.h"
+
+class ANPC_BaseCharacter;
+
+// Most significant first
+UENUM(BlueprintType)
+enum class ENPCSignificance : uint8
+{
+	Critical,
+	High,
+	Medium,
+	Low,
+	Dormant
+};
+
+// What an NPC is allowed to spend at a given significance, intervals in seconds (0 = every frame)
+struct FNPCSignificanceSettings
+{
+	float ActorTickInterval = 0.0f;
+	float AnimationTickInterval = 0.0f;
+	float StateTreeTickInterval = 0.0f;
+	float ControllerTickInterval = 0.0f;
+	float SightCheckInterval = 0.0f;
+	bool bEnableSight = true;
+	bool bEnableUpdateRateOptimizations = true;
+	EVisibilityBasedAnimTickOption VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+	static const FNPCSignificanceSettings& Get(ENPCSignificance Significance);
+};
+
+struct FNPCSignificanceEntry
+{
+	TWeakObjectPtr<ANPC_BaseCharacter> NPC;
+	ENPCSignificance Significance = ENPCSignificance::Critical;
+};
+
+/**
+ * Scores every registered NPC by distance to the player's view, whether it was rendered recently and whether it
+ * is in combat or dialogue, and sorts it into a significance bucket. NPCs only get told when their bucket
+ * changes; the bucket decides actor, animation, StateTree and controller tick rates and how often sight is checked.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UNPCSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterNPC(ANPC_BaseCharacter* NPC);
+	void UnregisterNPC(ANPC_BaseCharacter* NPC);
+
+	UFUNCTION(BlueprintPure, Category = "NPC | Significance")
+	int32 GetNumNPCsWithSignificance(ENPCSignificance Significance) const;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	// Seconds between two scoring passes
+	static constexpr float UpdateInterval = 0.25f;
+
+	// Upper bounds of the Critical..Low distance bands, anything further is Dormant
+	static constexpr float CriticalDistance = 800.0f;
+	static constexpr float HighDistance = 2000.0f;
+	static constexpr float MediumDistance = 4500.0f;
+	static constexpr float LowDistance = 9000.0f;
+
+	// An NPC has to move this far past a band edge before it drops into the next band, keeps it from flickering
+	static constexpr float DemotionHysteresis = 250.0f;
+
+	// How long an NPC off screen still counts as visible
+	static constexpr float VisibilityGracePeriod = 0.5f;
+
+private:
+	TArray<FNPCSignificanceEntry> Entries;
+
+	float TimeSinceUpdate = 0.0f;
+
+	ENPCSignificance ScoreNPC(const ANPC_BaseCharacter& NPC, ENPCSignificance CurrentSignificance, const FVector& ViewLocation) const;
+};
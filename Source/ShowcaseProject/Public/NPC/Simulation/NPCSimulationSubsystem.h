@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NPCSimulationSubsystem.generated.h"
+
+class ANPC_BaseCharacter;
+
+/**
+ * Scalar NPC state that changes with time (alertness decay, health regeneration delay, time in state, death
+ * cleanup deadline) kept in parallel arrays and advanced for every NPC in one pass per fixed step, spread over
+ * worker threads once there are enough NPCs. NPCs only hear back when something crosses a threshold: alertness
+ * drops below CalmAlertness, regenerating health passes another RegenPublishFraction of the maximum or reaches it,
+ * or the cleanup deadline passes.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UNPCSimulationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	void RegisterNPC(ANPC_BaseCharacter* NPC);
+	void UnregisterNPC(ANPC_BaseCharacter* NPC);
+
+	// Alertness is 0 to 1 and decays back to 0 at the NPC's AlertnessDecayRate per second
+	void RaiseAlertness(const ANPC_BaseCharacter* NPC, float Amount);
+	float GetAlertness(const ANPC_BaseCharacter* NPC) const;
+
+	void NotifyStateChanged(const ANPC_BaseCharacter* NPC);
+	float GetTimeInState(const ANPC_BaseCharacter* NPC) const;
+
+	// Restarts the regeneration delay, the NPC regenerates until it is back at full health
+	void NotifyDamaged(const ANPC_BaseCharacter* NPC);
+
+	void ScheduleCleanup(const ANPC_BaseCharacter* NPC, float Delay);
+	void CancelCleanup(const ANPC_BaseCharacter* NPC);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	static constexpr float SimulationStep = 0.1f;
+
+	// Caps the catch-up after a hitch
+	static constexpr int32 MaxStepsPerFrame = 4;
+
+	// Below this many NPCs a step is cheaper on the game thread than the ParallelFor dispatch
+	static constexpr int32 ParallelForMinNPCs = 256;
+
+	// Falling below this from above hands the NPC OnAlertnessCalmed
+	static constexpr float CalmAlertness = 0.2f;
+
+	// Regenerating health is handed to the NPC each time it passes another such share of its maximum
+	static constexpr float RegenPublishFraction = 0.1f;
+
+private:
+	enum ENPCSimulationFlags : uint8
+	{
+		Flag_Alive = 1 << 0,
+		Flag_Regenerating = 1 << 1,
+		Flag_CleanupPending = 1 << 2,
+	};
+
+	enum ENPCSimulationEvents : uint8
+	{
+		Event_Calmed = 1 << 0,
+		Event_Regenerate = 1 << 1,
+		Event_CleanupDue = 1 << 2,
+	};
+
+	// One entry per NPC at the same index in every array, removal swaps the last entry in
+	TArray<TWeakObjectPtr<ANPC_BaseCharacter>> NPCs;
+	TArray<float> Alertness;
+	TArray<float> AlertnessDecayRates;
+	TArray<float> RegenDelays;
+
+	// Only meaningful while Flag_Regenerating is set, seeded from the NPC when it is hit
+	TArray<float> RegenHealths;
+	TArray<float> RegenMaxHealths;
+	TArray<float> RegenRates;
+	TArray<float> TimesInState;
+	TArray<float> CleanupDelays;
+	TArray<uint8> Flags;
+	TArray<uint8> Events;
+
+	float TimeSinceStep = 0.0f;
+
+	int32 FindIndex(const ANPC_BaseCharacter* NPC) const;
+	void RemoveAtSwap(int32 Index);
+
+	void Step();
+	void StepEntry(int32 Index);
+	void DispatchEvents();
+};
@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NPC/SmartObject/SmartObject.h"
+#include "NPC/SmartObject/SmartObjectClaim.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "World/SpatialHashGrid.h"
+#include <atomic>
+#include "ShowcaseSmartObjectSubsystem.generated.h"
+
+struct FSmartObjectEntry
+{
+	TWeakObjectPtr<ASmartObject> Object;
+	ESmartObjectType Type = ESmartObjectType::Custom;
+	FVector Location = FVector::ZeroVector;
+
+	// Bit per slot, set while the slot is free
+	std::atomic<uint64> FreeSlots{0};
+
+	// Serial of the claim holding each slot, 0 while free
+	TArray<std::atomic<uint32>, TInlineAllocator<4>> ClaimSerials;
+
+	// Slot world locations cached at registration, smart objects do not move
+	TArray<FVector, TInlineAllocator<4>> SlotLocations;
+};
+
+/**
+ * Every smart object in the world, in one spatial grid per ESmartObjectType, with a free-slot bitmask per object.
+ * Finding the nearest free slot of a type only visits objects of that type in the grid cells the radius touches,
+ * and full objects are skipped on their mask without touching the actor. Objects support up to MaxSlots slots.
+ *
+ * Slots are taken through claims: a claim atomically clears the slot's bit, whoever cleared it owns the slot, and
+ * stamps the slot with a unique serial. Finding, claiming, releasing and validating are safe from worker threads; registration takes a write
+ * lock on the game thread. Claims whose user is gone or dead are released by a sweep every StaleClaimSweepInterval.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UShowcaseSmartObjectSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Returns the registry id the object keeps for its claims, game thread only
+	int32 RegisterSmartObject(ASmartObject* SmartObject);
+	void UnregisterSmartObject(int32 RegistryId);
+
+	uint64 GetFreeSlots(int32 RegistryId) const;
+
+	// Nearest free slot of Type within Radius of Location, unset if there is none
+	FSmartObjectSlotRef FindNearestFreeSlot(ESmartObjectType Type, const FVector& Location, float Radius) const;
+
+	// Claims the slot for User, the handle is unset if someone else holds it
+	FSmartObjectClaimHandle ClaimSlot(const FSmartObjectSlotRef& Slot, const AActor* User);
+
+	// Finds and claims in one go, moving on to the next nearest slot when another thread was faster
+	FSmartObjectClaimHandle ClaimNearestFreeSlot(ESmartObjectType Type, const FVector& Location, float Radius, const AActor* User);
+
+	// Returns false if the claim was already released
+	bool ReleaseClaim(const FSmartObjectClaimHandle& Claim);
+	bool IsClaimValid(const FSmartObjectClaimHandle& Claim) const;
+
+	// Game thread only, lets the smart objects know
+	void ReleaseClaimsForUser(const AActor* User);
+
+	// Game thread only, null once the object is gone
+	ASmartObject* GetSmartObject(int32 RegistryId) const;
+
+	int32 GetNumSmartObjects(ESmartObjectType Type) const;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	static constexpr int32 MaxSlots = 64;
+	static constexpr float StaleClaimSweepInterval = 1.0f;
+
+	// Attempts ClaimNearestFreeSlot makes before giving up under contention
+	static constexpr int32 MaxClaimAttempts = 4;
+
+private:
+	static constexpr int32 NumTypes = static_cast<int32>(ESmartObjectType::Custom) + 1;
+
+	// Guards Entries and the grids, claims only need the read side
+	mutable FRWLock RegistryLock;
+
+	TSparseArray<FSmartObjectEntry> Entries;
+
+	// Default cell size, close to the radius NPCs search for a seat in
+	TSpatialHashGrid<int32> GridsByType[NumTypes];
+
+	std::atomic<uint32> LastClaimSerial{0};
+
+	// Claims per user for the stale sweep and ReleaseClaimsForUser
+	FCriticalSection ClaimsByUserLock;
+	TMap<FObjectKey, TArray<FSmartObjectClaimHandle, TInlineAllocator<1>>> ClaimsByUser;
+
+	// ClaimsByUser.Num() as of its last change, for IsTickable which cannot take the lock
+	std::atomic<int32> NumClaimUsers{0};
+
+	float TimeSinceSweep = 0.0f;
+
+	FORCEINLINE TSpatialHashGrid<int32>& GetGrid(ESmartObjectType Type) { return GridsByType[static_cast<int32>(Type)]; }
+	FORCEINLINE const TSpatialHashGrid<int32>& GetGrid(ESmartObjectType Type) const { return GridsByType[static_cast<int32>(Type)]; }
+
+	FSmartObjectSlotRef FindNearestFreeSlotLocked(ESmartObjectType Type, const FVector& Location, float Radius) const;
+	FSmartObjectClaimHandle ClaimSlotLocked(const FSmartObjectSlotRef& Slot, const AActor* User);
+	bool ReleaseClaimLocked(const FSmartObjectClaimHandle& Claim);
+
+	void TrackClaim(const FSmartObjectClaimHandle& Claim);
+	void UntrackClaim(const FSmartObjectClaimHandle& Claim);
+
+	void SweepStaleClaims();
+	int32 ReleaseAndNotify(TConstArrayView<FSmartObjectClaimHandle> Claims);
+};
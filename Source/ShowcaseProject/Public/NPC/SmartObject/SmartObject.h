@@ -5,6 +5,7 @@
 #include "GameplayTagContainer.h"
 #include "GameFramework/Actor.h"
 #include "Interfaces/InteractionInterface.h"
+#include "NPC/SmartObject/SmartObjectClaim.h"
 #include "SmartObject.generated.h"
 
 class UBehaviorTree;
@@ -112,8 +113,15 @@ public:
     virtual void Interact(AShowcaseProjectCharacter* PlayerCharacter) override;
     int32 GetSlotIndexForUser(AActor* User) const;
 
+    // Id in UShowcaseSmartObjectSubsystem, for claiming this object's slots off the game thread
+    FORCEINLINE int32 GetRegistryId() const { return RegistryId; }
+
+    // A claim made through ReserveSlot was released by the registry, e.g. because its user died
+    void HandleClaimReleased(const FSmartObjectClaimHandle& Claim);
+
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smart Object")
     UBillboardComponent* BillboardComponent;
@@ -124,15 +132,22 @@ protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     USphereComponent* InteractionSphere;
 
-    // Track users with their assigned slots
-    UPROPERTY(BlueprintReadOnly, Category = "Smart Object")
-    TMap<AActor*, int32> UserSlotAssignments;
+    // Claims taken through ReserveSlot, by user
+    TMap<TWeakObjectPtr<AActor>, FSmartObjectClaimHandle> UserClaims;
 
     void GenerateDefaultSlots();
     void UpdateInteractionSphere();
 
+    // Registers the object with UShowcaseSmartObjectSubsystem again, after its slots changed
+    void RefreshRegistration();
+
 private:
     float GetDistanceToUser(AActor* User) const;
     bool IsUserValid(AActor* User) const;
     void ReleaseSlot(int32 SlotIndex);
+
+    // Bit per free slot, from the registry when registered
+    uint64 GetFreeSlotMask() const;
+
+    int32 RegistryId = INDEX_NONE;
 };
\ No newline at end of file
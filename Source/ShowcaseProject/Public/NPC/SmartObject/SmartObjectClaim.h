@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+// A slot of a registered smart object
+struct FSmartObjectSlotRef
+{
+	int32 RegistryId = INDEX_NONE;
+	int32 SlotIndex = INDEX_NONE;
+
+	FORCEINLINE bool IsSet() const { return RegistryId != INDEX_NONE && SlotIndex != INDEX_NONE; }
+};
+
+// Proof of holding a slot, check it with UShowcaseSmartObjectSubsystem::IsClaimValid before acting on it
+struct FSmartObjectClaimHandle
+{
+	int32 RegistryId = INDEX_NONE;
+	int32 SlotIndex = INDEX_NONE;
+
+	// Unique per claim, so a handle never validates against a later claim of the same slot
+	uint32 Serial = 0;
+
+	FObjectKey User;
+
+	FORCEINLINE bool IsSet() const { return Serial != 0; }
+	FORCEINLINE bool operator==(const FSmartObjectClaimHandle& Other) const
+	{
+		return RegistryId == Other.RegistryId && SlotIndex == Other.SlotIndex && Serial == Other.Serial && User == Other.User;
+	}
+};
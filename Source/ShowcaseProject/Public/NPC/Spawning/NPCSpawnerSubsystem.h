@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NPCSpawnerSubsystem.generated.h"
+
+class ANPC_BaseCharacter;
+class UNPCArchetype;
+
+DECLARE_DELEGATE_OneParam(FOnNPCSpawned, ANPC_BaseCharacter*);
+
+struct FNPCSpawnRequest
+{
+	TSubclassOf<ANPC_BaseCharacter> NPCClass;
+	FDataTableRowHandle NPCDataHandle;
+	FTransform Transform;
+
+	// Prewarm requests go straight into the pool
+	bool bPoolOnly = false;
+
+	FOnNPCSpawned OnSpawned;
+};
+
+/**
+ * Spawns NPCs from pools of deactivated actors, one pool per class and archetype. Queued requests are served within
+ * a per-frame budget: a pooled NPC is reset and re-possessed by its old controller, which is cheap, while a fresh
+ * actor (construction, component registration, possession, StateTree and data table setup) is only built a couple
+ * of times per frame. Dead and demoted NPCs are released back into their pool instead of being destroyed.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UNPCSpawnerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Queues a spawn served within the frame budget, OnSpawned runs once the NPC is in the world
+	void RequestSpawn(TSubclassOf<ANPC_BaseCharacter> NPCClass, const FDataTableRowHandle& NPCDataHandle, const FTransform& Transform,
+		FOnNPCSpawned OnSpawned = FOnNPCSpawned());
+
+	// Queues Count NPCs built straight into the pool, e.g. while a level loads ahead of a wave
+	void Prewarm(TSubclassOf<ANPC_BaseCharacter> NPCClass, const FDataTableRowHandle& NPCDataHandle, int32 Count);
+
+	// Spawns now, for callers that already budget themselves
+	ANPC_BaseCharacter* AcquireNPC(TSubclassOf<ANPC_BaseCharacter> NPCClass, const FDataTableRowHandle& NPCDataHandle, const FTransform& Transform);
+
+	// Deactivates the NPC into its pool, destroying it if the pool is full
+	void ReleaseNPC(ANPC_BaseCharacter* NPC);
+
+	int32 GetNumPooled() const;
+	FORCEINLINE int32 GetNumQueued() const { return Queue.Num(); }
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	// Fresh actors and pooled resets served per frame
+	static constexpr int32 MaxNewSpawnsPerFrame = 2;
+	static constexpr int32 MaxRespawnsPerFrame = 6;
+
+	static constexpr int32 MaxPooledPerArchetype = 16;
+
+private:
+	using FNPCPoolKey = TPair<const UClass*, const UNPCArchetype*>;
+
+	TMap<FNPCPoolKey, TArray<TWeakObjectPtr<ANPC_BaseCharacter>>> Pools;
+
+	// Served in order
+	TArray<FNPCSpawnRequest> Queue;
+
+	FNPCPoolKey GetPoolKey(TSubclassOf<ANPC_BaseCharacter> NPCClass, const FDataTableRowHandle& NPCDataHandle) const;
+	ANPC_BaseCharacter* TakeFromPool(const FNPCPoolKey& Key);
+	ANPC_BaseCharacter* SpawnNew(TSubclassOf<ANPC_BaseCharacter> NPCClass, const FDataTableRowHandle& NPCDataHandle, const FTransform& Transform);
+};
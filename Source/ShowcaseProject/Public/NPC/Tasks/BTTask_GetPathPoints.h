@@ -6,8 +6,13 @@
 #include "BehaviorTree/Tasks/BTTask_BlackboardBase.h"
 #include "BTTask_GetPathPoints.generated.h"
 
+class ANPC_AIController;
+class APatrolPath;
+
 /**
- * 
+ * Writes the world location of the NPC's current patrol point to MoveToLocationVectorKey. With
+ * bMoveAlongCachedPath it also walks there itself, following the leg path APatrolPath shares between every NPC
+ * on the route; only when the NPC is not standing at the previous patrol point does it pathfind on its own.
  */
 UCLASS()
 class SHOWCASEPROJECT_API UBTTask_GetPathPoints : public UBTTask_BlackboardBase
@@ -17,7 +22,26 @@ class SHOWCASEPROJECT_API UBTTask_GetPathPoints : public UBTTask_BlackboardBase
 public:
 	explicit UBTTask_GetPathPoints(const FObjectInitializer& ObjectInitializer);
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void OnMessage(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, FName Message, int32 RequestID, bool bSuccess) override;
+
+	// How close to its last patrol point the NPC has to be for the next leg to use the shared path
+	static constexpr float LegStartTolerance = 150.0f;
+
 private:
 	UPROPERTY(EditAnywhere, Category = "Path Points", meta = (AllowPrivateAccess = "true"))
 	FBlackboardKeySelector MoveToLocationVectorKey;
+
+	// Off, the task only sets MoveToLocationVectorKey for a MoveTo that follows it
+	UPROPERTY(EditAnywhere, Category = "Path Points", meta = (AllowPrivateAccess = "true"))
+	bool bMoveAlongCachedPath = true;
+
+	UPROPERTY(EditAnywhere, Category = "Path Points", meta = (AllowPrivateAccess = "true", EditCondition = "bMoveAlongCachedPath"))
+	float AcceptanceRadius = 50.0f;
+
+	// The node is instanced per NPC, so these track this NPC's walk along the route
+	int32 LastReachedIndex = INDEX_NONE;
+	int32 PendingIndex = INDEX_NONE;
+
+	EBTNodeResult::Type MoveToPatrolPoint(UBehaviorTreeComponent& OwnerComp, ANPC_AIController& Controller, APatrolPath& PatrolPath, int32 Index);
 };
@@ -14,8 +14,15 @@ enum class EDirectionType
 };
 
 
+struct FBTIncrementPathIndexMemory
+{
+	// Per NPC, the node itself is shared by every NPC running the tree
+	EDirectionType Direction = EDirectionType::Forward;
+};
+
 /**
- * 
+ * Moves the path index to the next patrol point of the NPC's APatrolPath, wrapping round the route or, with
+ * bBiDirectional, turning back at either end.
  */
 UCLASS()
 class SHOWCASEPROJECT_API UBTTask_IncrementPathIndex : public UBTTask_BlackboardBase
@@ -25,8 +32,10 @@ class SHOWCASEPROJECT_API UBTTask_IncrementPathIndex : public UBTTask_Blackboard
 public:
 	explicit UBTTask_IncrementPathIndex(const FObjectInitializer& ObjectInitializer);
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual uint16 GetInstanceMemorySize() const override { return sizeof(FBTIncrementPathIndexMemory); }
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
 private:
-	EDirectionType Direction = EDirectionType::Forward;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI", meta= (AllowPrivateAccess = "true"))
 	bool bBiDirectional = false;
 	
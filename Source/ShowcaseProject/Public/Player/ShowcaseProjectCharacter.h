@@ -9,6 +9,7 @@
 #include "ShowcaseProjectCharacter.generated.h"
 
 class UAIPerceptionStimuliSourceComponent;
+class UAimComponent;
 enum class EWeaponSlot : uint8;
 class UWeaponSystemComponent;
 class UInventoryComponent;
@@ -60,6 +61,7 @@ public:
 	FORCEINLINE bool IsAiming() const { return bIsAiming; }
 	FORCEINLINE UInventoryComponent* GetInventory() const { return PlayerInventory; }
 	FORCEINLINE UWeaponSystemComponent* GetWeaponSystem() const { return WeaponSystemComponent; }
+	FORCEINLINE UAimComponent* GetAimComponent() const { return AimComponent; }
 	FORCEINLINE AShowcaseHUD* GetHUD() const { return HUD; }
 	FORCEINLINE bool IsPlayingAnimation() const { return bIsPlayingAnimation; }
 	void UpdateInteractionWidget() const;
@@ -154,6 +156,10 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Character | Weapon")
 	UWeaponSystemComponent* WeaponSystemComponent;
 
+	/** Shared per-frame crosshair ray and aim target */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Character | Aiming")
+	UAimComponent* AimComponent;
+
 	/** Is Aiming */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Character | Aiming")
 	bool bIsAiming = false;
@@ -180,8 +186,6 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aiming")
 	float FiringRotationSpeed = 15.0f;
 
-	FVector CrosshairWorldDirection;
-
 	UAIPerceptionStimuliSourceComponent* StimuliSource;
 	
 	//Functions
@@ -195,7 +199,6 @@ protected:
 	void Interact();
 	void BeginAim();
 	void EndAim();
-	void UpdateCrosshairDirection();
 	void RotateTowardsCrosshair(float RotationSpeed, float DeltaTime);
 	void SetupStimuliSource();
 	void BeginFire();
@@ -44,7 +44,8 @@ public:
     UButton* GetInternalButton() const { return InternalButton; }
 
 protected:
-    virtual void NativeConstruct() override;
+    // Bindings, fallback widgets and styling are set up once per widget lifetime, pooled buttons only get re-bound
+    virtual void NativeOnInitialized() override;
     virtual void NativePreConstruct() override;
 
     // Widget bindings - these will be bound in Blueprint
@@ -42,6 +42,8 @@ public:
 	FOnChoiceSelectedDelegate OnChoiceSelected;
 
 protected:
+	virtual void NativeOnInitialized() override;
+
 	virtual void NativeConstruct() override;
 
 	virtual void NativeDestruct() override;
@@ -66,6 +68,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue | Choice Button")
 	float ChoiceButtonSpacing = 5.0f;
 
+	// Buttons created up front and re-bound for every node, the pool only grows if a node offers more choices
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue | Choice Button", meta = (ClampMin = "1"))
+	int32 ChoiceButtonPoolSize = 6;
+
 
 private:
 	// Critical: Use weak pointer for cross-system references
@@ -79,8 +85,13 @@ private:
 	void HandleChoiceButtonClicked(UChoiceButton* ClickedButton, int32 ChoiceIndex);
 	
 	void CleanupDialogueBinding();
-	void CleanupChoiceButtons();
+	void HideChoiceButtons();
 	void ApplyChoiceButtonStyling(UChoiceButton* ChoiceButton);
-    
+	UChoiceButton* AddPooledChoiceButton();
+
+	// Pool of choice buttons, the first NumActiveChoiceButtons are bound to the current node
+	UPROPERTY()
 	TArray<UChoiceButton*> ChoiceButtons;
+
+	int32 NumActiveChoiceButtons = 0;
 };
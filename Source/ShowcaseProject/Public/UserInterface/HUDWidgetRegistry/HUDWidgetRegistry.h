@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "HUDWidgetRegistry.generated.h"
+
+class UUserWidget;
+class APlayerController;
+
+UENUM(BlueprintType)
+enum class EHUDWidget : uint8
+{
+	MainMenu UMETA(DisplayName = "Main Menu"),
+	WeaponHUD UMETA(DisplayName = "Weapon HUD"),
+	InventoryMenu UMETA(DisplayName = "Inventory Menu"),
+	Interaction UMETA(DisplayName = "Interaction"),
+	Dialogue UMETA(DisplayName = "Dialogue"),
+	Count UMETA(Hidden)
+};
+
+DECLARE_DELEGATE_TwoParams(FOnHUDWidgetCreated, EHUDWidget /*WidgetId*/, UUserWidget* /*Widget*/);
+
+USTRUCT()
+struct FHUDWidgetEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	TSubclassOf<UUserWidget> WidgetClass;
+
+	UPROPERTY()
+	UUserWidget* Widget = nullptr;
+
+	// Viewport Z order the widget is added with
+	int32 ZOrder = 0;
+
+	// Seconds a hidden widget may sit unused before it is released, 0 keeps it resident once created
+	float UnloadAfterIdleSeconds = 0.0f;
+
+	bool bIsShown = false;
+
+	// Real time the widget was last hidden, so slowed-down game time does not delay unloading
+	double LastHiddenTime = 0.0;
+};
+
+/**
+ * Owns the HUD's widgets and creates each one the first time it is needed instead of at map start.
+ * Widgets can be pre-warmed explicitly (e.g. behind a loading screen) and heavy menus are released
+ * again after they have been hidden for a while.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UHUDWidgetRegistry : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UHUDWidgetRegistry();
+
+	void Initialize(APlayerController* InOwningPlayer);
+
+	void RegisterWidget(EHUDWidget WidgetId, TSubclassOf<UUserWidget> WidgetClass, int32 ZOrder, float UnloadAfterIdleSeconds = 0.0f);
+
+	// Returns the widget only if it already exists
+	UUserWidget* FindWidget(EHUDWidget WidgetId) const;
+
+	// Returns the widget, creating it and adding it collapsed to the viewport on first use
+	UUserWidget* GetOrCreateWidget(EHUDWidget WidgetId);
+
+	template<typename WidgetT>
+	WidgetT* FindWidget(EHUDWidget WidgetId) const { return Cast<WidgetT>(FindWidget(WidgetId)); }
+
+	template<typename WidgetT>
+	WidgetT* GetOrCreateWidget(EHUDWidget WidgetId) { return Cast<WidgetT>(GetOrCreateWidget(WidgetId)); }
+
+	// Creates the widget ahead of time without showing it
+	void PrewarmWidget(EHUDWidget WidgetId);
+
+	void MarkShown(EHUDWidget WidgetId);
+	void MarkHidden(EHUDWidget WidgetId);
+
+	// Releases hidden widgets that have been idle longer than their unload delay
+	void UnloadIdleWidgets();
+
+	void UnloadWidget(EHUDWidget WidgetId);
+
+	// Lets the HUD apply per-widget setup (slot layout, bindings) right after creation
+	FOnHUDWidgetCreated OnWidgetCreated;
+
+private:
+	UPROPERTY()
+	TArray<FHUDWidgetEntry> Entries;
+
+	UPROPERTY()
+	APlayerController* OwningPlayer;
+
+	double GetRealTimeSeconds() const;
+};
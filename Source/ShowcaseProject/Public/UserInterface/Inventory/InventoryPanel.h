@@ -22,7 +22,7 @@ class SHOWCASEPROJECT_API UInventoryPanel : public UUserWidget
 
 public:
 	UFUNCTION()
-	void RefreshInventory();
+	virtual void RefreshInventory();
 
 	UFUNCTION()
 	void CloseActiveContextMenu();
@@ -32,7 +32,8 @@ public:
 	UPROPERTY()
 	UInventoryContextMenu* ActiveContextMenu;
 
-	UPROPERTY(meta=(BindWidget))
+	// Optional so virtualized subclasses can replace the wrap box with their own list
+	UPROPERTY(meta=(BindWidgetOptional))
 	UWrapBox* InventoryPanel;
 	
 	UPROPERTY(meta=(BindWidget))
@@ -53,4 +54,6 @@ public:
 protected:
 	void SetInfoText() const;
 	virtual void NativeOnInitialized() override;
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 };
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "Blueprint/IUserObjectListEntry.h"
 #include "InventoryItemSlot.generated.h"
 
 class UInventoryContextMenu;
@@ -17,7 +18,7 @@ class UInventoryPanel;
  * 
  */
 UCLASS()
-class SHOWCASEPROJECT_API UInventoryItemSlot : public UUserWidget
+class SHOWCASEPROJECT_API UInventoryItemSlot : public UUserWidget, public IUserObjectListEntry
 {
 	GENERATED_BODY()
 
@@ -25,6 +26,9 @@ public:
 	FORCEINLINE void SetItemReference(UItemBase* ItemIn) { ItemReference = ItemIn; }
 	FORCEINLINE UItemBase* GetItemReference() const { return ItemReference; }
 	FORCEINLINE void SetOwningInventoryPanel(UInventoryPanel* InventoryPanel) { OwningInventoryPanel = InventoryPanel; }
+
+	// Pushes the current item's quality, icon and quantity to the slot widgets
+	void RefreshSlot();
 protected:
 
 	UPROPERTY()
@@ -36,6 +40,10 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category="Inventory Slot")
 	TSubclassOf<UInventoryTooltip> InventoryTooltipClass;
 
+	// Created once and refilled whenever the slot is rebound
+	UPROPERTY()
+	UInventoryTooltip* Tooltip;
+
 	UPROPERTY(VisibleAnywhere, Category="Inventory Slot")
 	UItemBase* ItemReference;
 	
@@ -50,6 +58,8 @@ protected:
 	
 	virtual void NativeOnInitialized() override;
 	virtual void NativeConstruct() override;
+	// Called when a tile view recycles this slot for a different item
+	virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
 	virtual FReply NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
 	virtual void NativeOnMouseLeave(const FPointerEvent& InMouseEvent) override;
 };
@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UserInterface/Inventory/InventoryPanel.h"
+#include "InventoryTilePanel.generated.h"
+
+class UTileView;
+class UUserWidget;
+
+/**
+ * Inventory panel backed by a virtualized tile view for large inventories (stash, vendor).
+ * Only the visible slots exist as widgets and they are recycled while scrolling. The tile view's
+ * entry class should be a UInventoryItemSlot blueprint, which keeps its tooltip and context menu.
+ */
+UCLASS()
+class SHOWCASEPROJECT_API UInventoryTilePanel : public UInventoryPanel
+{
+	GENERATED_BODY()
+
+public:
+	virtual void RefreshInventory() override;
+
+protected:
+	UPROPERTY(meta=(BindWidget))
+	UTileView* InventoryTileView;
+
+	virtual void NativeOnInitialized() override;
+
+private:
+	void HandleEntryWidgetGenerated(UUserWidget& EntryWidget);
+};
@@ -50,6 +50,9 @@ public:
 
 	UPROPERTY(meta=(BindWidget))
 	UTextBlock* MaxStackSize;
+
+	// Fills the fields from the hovered slot's current item
+	void RefreshTooltip();
 	
 protected:
 	virtual void NativeConstruct() override;
@@ -3,7 +3,9 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Ticker.h"
 #include "GameFramework/HUD.h"
+#include "UserInterface/HUDWidgetRegistry/HUDWidgetRegistry.h"
 #include "ShowcaseHUD.generated.h"
 
 struct FDialogueNode;
@@ -15,6 +17,7 @@ class UWeaponHUD;
 class AWeaponBase;
 class UDialogueWidget;
 class UDialogueComponent;
+class UCurveFloat;
 
 /**
  * 
@@ -40,6 +43,17 @@ public:
 
 	UPROPERTY(EditDefaultsOnly, Category = "Widgets")
 	TSubclassOf<UDialogueWidget> DialogueWidgetClass;
+
+	// Widgets created up front by PrewarmWidgets, everything else is created the first time it is shown
+	UPROPERTY(EditDefaultsOnly, Category = "Widgets | Loading")
+	TArray<EHUDWidget> PrewarmedWidgets;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Widgets | Loading")
+	bool bPrewarmOnBeginPlay = false;
+
+	// Real seconds a hidden menu stays resident before it is released, 0 keeps menus loaded
+	UPROPERTY(EditDefaultsOnly, Category = "Widgets | Loading")
+	float MenuUnloadDelay = 60.0f;
 	
 	bool bIsInventoryMenuVisible;
 
@@ -47,17 +61,23 @@ public:
 
 	//FUNCTIONS
 	AShowcaseHUD();
-	FORCEINLINE UWeaponHUD* GetWeaponHUD() const { return WeaponHUDWidget; }
+	UWeaponHUD* GetWeaponHUD();
+
+	// Creates the configured PrewarmedWidgets ahead of time, call while a loading screen is up
+	UFUNCTION(BlueprintCallable, Category="HUD | Widgets")
+	void PrewarmWidgets();
+
 	void ToggleInventoryMenu();
 	void ToggleMainMenu();
-	void ShowInteractionWidget() const;
-	void HideInteractionWidget() const;
-	void UpdateInteractionWidget(const FInteractableData* InteractableData) const;
+	void ShowInteractionWidget();
+	void HideInteractionWidget();
+	void UpdateInteractionWidget(const FInteractableData* InteractableData);
 	void UpdateWeaponDisplay(AWeaponBase* EquippedWeapon);
 	void OnWeaponAimStart();
 	void OnWeaponAimStop();
 	void OnWeaponFired();
 	void OnWeaponStoppedFiring();
+	void OnAimTargetChanged(AActor* NewTarget);
 
 	UFUNCTION(BlueprintCallable, Category="HUD | Dialogue")
 	void ShowDialogue(const FDialogueNode& DialogueNode, UDialogueComponent* DialogueComponent);
@@ -69,33 +89,32 @@ protected:
 
 	//PROPERTIES
 	UPROPERTY()
-	UMainMenu* MainMenuWidget;
-	
-	UPROPERTY()
-	UInventoryMenu* InventoryMenuWidget;
+	UHUDWidgetRegistry* WidgetRegistry;
 
-	UPROPERTY()
-	UWeaponHUD* WeaponHUDWidget;
+	// Core ticker rather than a world timer, so slow-mo and pauses do not stretch the unload delay
+	FTSTicker::FDelegateHandle WidgetUnloadTickerHandle;
 
-	UPROPERTY()
-	UDialogueWidget* DialogueWidget;
-	
-	UPROPERTY()
-	UInteractionWidget* InteractionWidget;
+	// Real seconds between checks of hidden menus for unloading
+	UPROPERTY(EditDefaultsOnly, Category = "Widgets | Loading")
+	float WidgetUnloadCheckInterval = 10.0f;
 
-	UPROPERTY()
-	FTimerHandle TimeDilationTimerHandle;
-	
-	UPROPERTY()
-	float CurrentTimeDilation = 1.0f;
-	
-	UPROPERTY()
-	float TargetTimeDilation = 1.0f;
+	// Slow-mo applied while the inventory is open
+	UPROPERTY(EditDefaultsOnly, Category="Time Dilation")
+	float InventoryTimeDilation = 0.1f;
+
+	UPROPERTY(EditDefaultsOnly, Category="Time Dilation")
+	int32 InventoryTimeDilationPriority = 10;
+
+	// Real seconds taken to blend into the inventory slow-mo
+	UPROPERTY(EditDefaultsOnly, Category="Time Dilation")
+	float InventoryTimeDilationBlendTime = 1.0f;
 
 	UPROPERTY(EditDefaultsOnly, Category="Time Dilation")
-	float TimeDilationInterpSpeed = 3.0f;
+	UCurveFloat* InventoryTimeDilationCurve;
 
 	//FUNCTIONS
 	virtual void BeginPlay() override;
-	void UpdateTimeDilation();
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	void OnWidgetCreated(EHUDWidget WidgetId, UUserWidget* Widget);
+	bool UnloadIdleWidgets(float DeltaTime);
 };
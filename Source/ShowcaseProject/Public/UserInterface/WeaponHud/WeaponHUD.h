@@ -9,6 +9,8 @@
 class UImage;
 class UTextBlock;
 class UWidgetAnimation;
+class UInvalidationBox;
+class UTexture2D;
 
 /**
  * 
@@ -18,6 +20,7 @@ class SHOWCASEPROJECT_API UWeaponHUD : public UUserWidget
 {
 	GENERATED_BODY()
 public:
+	virtual void NativeOnInitialized() override;
 	virtual void NativeConstruct() override;
 
 	UFUNCTION(BlueprintCallable)
@@ -52,6 +55,10 @@ public:
 
 	UFUNCTION(BlueprintCallable)
 	void HideCrosshair();
+
+	// Tints the crosshair while the shared aim trace is over something that can take damage
+	UFUNCTION(BlueprintCallable)
+	void SetCrosshairOverTarget(bool bOverTarget);
 	
 protected:
 	UPROPERTY(meta = (BindWidget))
@@ -66,6 +73,10 @@ protected:
 	UPROPERTY(meta = (BindWidget))
 	UTextBlock* AmmoSeparatorText;
 
+	// Optional root wrapper so the HUD is cached and only repainted when one of its children changes
+	UPROPERTY(meta = (BindWidgetOptional))
+	UInvalidationBox* WeaponHUDInvalidationBox;
+
 	UPROPERTY(Transient, meta = (BindWidgetAnim))
 	UWidgetAnimation* FadeInAnimation;
 
@@ -75,12 +86,38 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Auto Hide")
 	float FireAutoHideDelay = 5.0f;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair")
+	FLinearColor TargetCrosshairColor = FLinearColor::Red;
+
+	// Ammo values up to this number are formatted once and reused
+	UPROPERTY(EditDefaultsOnly, Category = "Ammo")
+	int32 MaxCachedAmmoValue = 999;
+
 private:
 	FTimerHandle FireAutoHideTimer;
     
 	bool bIsAiming = false;
 	bool bIsFiring = false;
 	bool bIsVisible = false;
+	bool bCrosshairOverTarget = false;
+
+	// Colour supplied by the equipped weapon, restored when the aim target is lost
+	FLinearColor WeaponCrosshairColor = FLinearColor::White;
+
+	// Last values pushed to the widgets, so repeated updates during fire are skipped
+	TWeakObjectPtr<UTexture2D> DisplayedWeaponIcon;
+	int32 DisplayedCurrentAmmo = INDEX_NONE;
+	int32 DisplayedTotalAmmo = INDEX_NONE;
+	TWeakObjectPtr<UTexture2D> DisplayedCrosshairTexture;
+	float DisplayedCrosshairSize = -1.0f;
+
+	// Pre-formatted ammo numbers, indexed by value
+	TArray<FText> AmmoTextCache;
+
+	FText AmmoTextFallback;
+
+	void BuildAmmoTextCache();
+	const FText& GetAmmoText(int32 AmmoValue);
 
 	void ShowWithAnimation();
 	void HideWithAnimation();
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform 2D hash grid over world XY. Elements are identified by a small hashable id (an index or handle) and
+ * live in exactly one cell; queries return every element of the cells a radius touches, so callers still run
+ * their exact distance test. Pick a cell size close to the typical query radius.
+ */
+template<typename IdType>
+class TSpatialHashGrid
+{
+public:
+	explicit TSpatialHashGrid(float InCellSize = 1000.0f)
+		: InvCellSize(1.0f / InCellSize)
+	{
+	}
+
+	FORCEINLINE FIntPoint GetCell(const FVector& Location) const
+	{
+		return FIntPoint(FMath::FloorToInt(Location.X * InvCellSize), FMath::FloorToInt(Location.Y * InvCellSize));
+	}
+
+	void Add(IdType Id, const FVector& Location)
+	{
+		const FIntPoint Cell = GetCell(Location);
+		Cells.FindOrAdd(Cell).Add(Id);
+		ElementCells.Add(Id, Cell);
+	}
+
+	void Remove(IdType Id)
+	{
+		FIntPoint Cell;
+		if (ElementCells.RemoveAndCopyValue(Id, Cell))
+		{
+			RemoveFromCell(Id, Cell);
+		}
+	}
+
+	// Moves the element to the cell of Location, returns true when it changed cell
+	bool Update(IdType Id, const FVector& Location)
+	{
+		FIntPoint* Cell = ElementCells.Find(Id);
+		if (!Cell)
+		{
+			Add(Id, Location);
+			return true;
+		}
+
+		const FIntPoint NewCell = GetCell(Location);
+		if (*Cell == NewCell) return false;
+
+		RemoveFromCell(Id, *Cell);
+		*Cell = NewCell;
+		Cells.FindOrAdd(NewCell).Add(Id);
+		return true;
+	}
+
+	FORCEINLINE bool Contains(IdType Id) const { return ElementCells.Contains(Id); }
+	FORCEINLINE int32 Num() const { return ElementCells.Num(); }
+
+	// Calls Func(Id) for every element in the cells overlapping the XY bounds of the sphere
+	template<typename FuncType>
+	void ForEachInRadius(const FVector& Center, float Radius, FuncType&& Func) const
+	{
+		const FIntPoint MinCell = GetCell(Center - FVector(Radius));
+		const FIntPoint MaxCell = GetCell(Center + FVector(Radius));
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				if (const TArray<IdType>* CellElements = Cells.Find(FIntPoint(X, Y)))
+				{
+					for (const IdType& Id : *CellElements)
+					{
+						Func(Id);
+					}
+				}
+			}
+		}
+	}
+
+	void Reset()
+	{
+		Cells.Reset();
+		ElementCells.Reset();
+	}
+
+private:
+	float InvCellSize;
+
+	// Emptied cells are kept so elements walking back and forth do not reallocate
+	TMap<FIntPoint, TArray<IdType>> Cells;
+	TMap<IdType, FIntPoint> ElementCells;
+
+	void RemoveFromCell(IdType Id, const FIntPoint& Cell)
+	{
+		if (TArray<IdType>* CellElements = Cells.Find(Cell))
+		{
+			CellElements->RemoveSingleSwap(Id, EAllowShrinking::No);
+		}
+	}
+};
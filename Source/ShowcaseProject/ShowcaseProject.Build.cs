@@ -25,6 +25,7 @@ public class ShowcaseProject : ModuleRules
 			"SlateCore",
 			"StateTreeModule",
 			"GameplayStateTreeModule",
+			"AssetRegistry",
 		});
 	}
 }